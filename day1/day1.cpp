@@ -1,10 +1,32 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+const int DIAL_POSITIONS = 100;
+
+// Floor division by a positive constant, without branching on the sign of value
+template <int N>
+inline int floorDiv(int value){
+    return value / N - (value % N < 0);
+}
 
 // Part 1
+template <int N = DIAL_POSITIONS>
 int mover(int current, int delta, char direction){
     if (direction == 'L') delta = -delta;
-    int result = (current + delta) % 100;
-    return (result < 0) ? result + 100 : result;
+    int target = current + delta;
+    return target - floorDiv<N>(target) * N;
 }
 
 // Part 2
@@ -66,12 +88,434 @@ std::pair<int, int> mover0x434C49434B(int current, int delta, char direction){
     return {newPosition, zerosPassedThrough};
 }
 
-int main(){
+// Branch-free equivalent of mover0x434C49434B for a dial with N positions.
+// Moving right from c to t hits 0 once per multiple of N in (c, t], moving left once
+// per multiple in [t, c); shifting both ends by one for left moves turns either case
+// into the difference of two floor divisions.
+template <int N>
+inline std::pair<int, int> turnDial(int current, int delta, char direction){
+    int left = (direction == 'L');
+    int target = current + delta - 2 * left * delta;
+    int newPosition = target - floorDiv<N>(target) * N;
+    int hits = std::abs(floorDiv<N>(target - left) - floorDiv<N>(current - left));
+    // mover0x434C49434B counts an extra pass when leaving 0 by whole rotations
+    hits += left & (current == 0) & (delta > 0) & (delta % N == 0);
+    // Hitting 0 at the end is reported by the caller, not as a pass
+    int zerosPassedThrough = hits - ((newPosition == 0) & (delta != 0));
+    return {newPosition, zerosPassedThrough};
+}
+
+// Reads the next instruction from text[i, end), advancing i past it.
+// Returns false once no instruction is left.
+bool nextInstruction(const std::string& text, size_t& i, size_t end, char& direction, int& delta){
+    while (i < end && text[i] != 'L' && text[i] != 'R') i++;
+    if (i == end) return false;
+    direction = text[i++];
+    while (i < end && (text[i] < '0' || text[i] > '9')) i++;
+    delta = 0;
+    while (i < end && text[i] >= '0' && text[i] <= '9') delta = delta * 10 + (text[i++] - '0');
+    return true;
+}
+
+// Parallel mode
+// Summary of one chunk of the log as a function of the position the dial has when
+// the chunk starts: where it ends, how many moves end at 0 (Part 1) and how many
+// times it points at 0 in total (Part 2).
+struct ChunkTable {
+    int end[DIAL_POSITIONS];
+    long long landed[DIAL_POSITIONS];
+    long long hits[DIAL_POSITIONS];
+};
+
+// The table that behaves like running `first` and then `second`
+ChunkTable compose(const ChunkTable& first, const ChunkTable& second){
+    ChunkTable result;
+    for (int s = 0; s < DIAL_POSITIONS; s++) {
+        int middle = first.end[s];
+        result.end[s] = second.end[middle];
+        result.landed[s] = first.landed[s] + second.landed[middle];
+        result.hits[s] = first.hits[s] + second.hits[middle];
+    }
+    return result;
+}
+
+// Builds the table for text[begin, end) in one pass over the chunk.
+// The path from start s is the path from 0 shifted by s, so it is enough to track the
+// offset from the chunk start: Part 1 is a histogram of offsets, and each move adds its
+// full rotations to every start plus one extra hit for a cyclic interval of starts,
+// which is recorded in a difference array.
+ChunkTable buildChunkTable(const std::string& text, size_t begin, size_t end){
+    long long offsetHistogram[DIAL_POSITIONS] = {};
+    long long extraHits[DIAL_POSITIONS + 1] = {};
+    long long fullRotations = 0;
+    int offset = 0;
+
+    // Adds one hit to every start s with (s + offset) % DIAL_POSITIONS in [low, high]
+    auto addHits = [&](int low, int high){
+        int from = ((low - offset) % DIAL_POSITIONS + DIAL_POSITIONS) % DIAL_POSITIONS;
+        int to = from + (high - low);
+        if (to < DIAL_POSITIONS) {
+            extraHits[from]++;
+            extraHits[to + 1]--;
+        } else {
+            extraHits[from]++;
+            extraHits[DIAL_POSITIONS]--;
+            extraHits[0]++;
+            extraHits[to - DIAL_POSITIONS + 1]--;
+        }
+    };
+
+    size_t i = begin;
+    char direction;
+    int delta;
+    while (nextInstruction(text, i, end, direction, delta)) {
+        int rotations = delta / DIAL_POSITIONS;
+        int remainder = delta % DIAL_POSITIONS;
+        fullRotations += rotations;
+        if (delta == 0) {
+            // Staying put on 0 still counts as ending at 0
+            addHits(0, 0);
+        } else if (direction == 'R') {
+            // Hits one more 0 when current + remainder reaches the next multiple
+            if (remainder > 0) addHits(DIAL_POSITIONS - remainder, DIAL_POSITIONS - 1);
+            offset = (offset + remainder) % DIAL_POSITIONS;
+        } else {
+            if (remainder > 0) addHits(1, remainder);
+            // mover0x434C49434B counts an extra pass when leaving 0 by whole rotations
+            else if (rotations > 0) addHits(0, 0);
+            offset = (offset - remainder + DIAL_POSITIONS) % DIAL_POSITIONS;
+        }
+        offsetHistogram[offset]++;
+    }
+
+    ChunkTable table;
+    long long running = 0;
+    for (int s = 0; s < DIAL_POSITIONS; s++) {
+        running += extraHits[s];
+        table.end[s] = (s + offset) % DIAL_POSITIONS;
+        table.landed[s] = offsetHistogram[(DIAL_POSITIONS - s) % DIAL_POSITIONS];
+        table.hits[s] = fullRotations + running;
+    }
+    return table;
+}
+
+void solveParallel(unsigned threadCount){
+    std::string text((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+
+    // Chunk boundaries are moved forward to the next instruction so none is split
+    std::vector<size_t> bounds{0};
+    for (unsigned t = 1; t < threadCount; t++) {
+        size_t bound = std::max(bounds.back(), text.size() * t / threadCount);
+        while (bound < text.size() && text[bound] != 'L' && text[bound] != 'R') bound++;
+        bounds.push_back(bound);
+    }
+    bounds.push_back(text.size());
+
+    std::vector<ChunkTable> tables(threadCount);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threadCount; t++) {
+        workers.emplace_back([&, t]{ tables[t] = buildChunkTable(text, bounds[t], bounds[t + 1]); });
+    }
+    for (std::thread& worker : workers) worker.join();
+
+    ChunkTable total = tables[0];
+    for (unsigned t = 1; t < threadCount; t++) total = compose(total, tables[t]);
+
+    std::cout<<"\nPart 1 Answer (only counting when dial ends at 0): "<<total.landed[50];
+    std::cout<<"\nPart 2 Answer (counting all occurrences of 0): "<<total.hits[50];
+}
+
+// Fleet mode
+// Number of dials simulated side by side; with AVX2 one step of all lanes is two
+// registers of eight 32-bit lanes each.
+const int FLEET_LANES = 16;
+
+#ifdef __AVX2__
+// floorDiv<N> on eight lanes. AVX2 has no integer division, so the value is biased to
+// a non-negative multiple-of-N offset and divided by multiplying with ceil(2^37 / N),
+// which is exact for every 32-bit unsigned value while that rounding error stays <= 32.
+template <int N>
+inline __m256i floorDiv8(__m256i value){
+    constexpr unsigned long long SHIFT = 37;
+    constexpr unsigned long long MAGIC = ((1ULL << SHIFT) + N - 1) / N;
+    static_assert(MAGIC * N - (1ULL << SHIFT) <= 32 && MAGIC < (1ULL << 32), "no 32-bit magic for N");
+    constexpr int BIAS_QUOTIENT = 0x7FFFFFFF / N;
+    __m256i biased = _mm256_add_epi32(value, _mm256_set1_epi32(BIAS_QUOTIENT * N));
+    __m256i magic = _mm256_set1_epi64x(MAGIC);
+    // _mm256_mul_epu32 multiplies the even lanes; the odd ones are shifted down first
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(biased, magic), SHIFT);
+    __m256i odd = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(biased, 32), magic), SHIFT);
+    __m256i quotient = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+    return _mm256_sub_epi32(quotient, _mm256_set1_epi32(BIAS_QUOTIENT));
+}
+
+// turnDial<N> on eight dials at once, with left holding all ones for 'L' lanes
+template <int N>
+inline void turnDial8(__m256i& position, __m256i delta, __m256i left, __m256i& zerosPassedThrough){
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i size = _mm256_set1_epi32(N);
+    __m256i current = position;
+    __m256i leftBit = _mm256_and_si256(left, one);
+    __m256i target = _mm256_add_epi32(current, _mm256_blendv_epi8(delta, _mm256_sub_epi32(zero, delta), left));
+    position = _mm256_sub_epi32(target, _mm256_mullo_epi32(floorDiv8<N>(target), size));
+    __m256i hits = _mm256_abs_epi32(_mm256_sub_epi32(floorDiv8<N>(_mm256_sub_epi32(target, leftBit)),
+                                                     floorDiv8<N>(_mm256_sub_epi32(current, leftBit))));
+    // mover0x434C49434B counts an extra pass when leaving 0 by whole rotations. Comparison
+    // masks are all ones (-1), so subtracting extra adds one and adding endsAtZero takes one off
+    __m256i remainder = _mm256_sub_epi32(delta, _mm256_mullo_epi32(floorDiv8<N>(delta), size));
+    __m256i extra = _mm256_and_si256(_mm256_and_si256(left, _mm256_cmpeq_epi32(current, zero)),
+                                     _mm256_and_si256(_mm256_cmpgt_epi32(delta, zero), _mm256_cmpeq_epi32(remainder, zero)));
+    hits = _mm256_sub_epi32(hits, extra);
+    // Hitting 0 at the end is reported by the caller, not as a pass
+    __m256i endsAtZero = _mm256_andnot_si256(_mm256_cmpeq_epi32(delta, zero), _mm256_cmpeq_epi32(position, zero));
+    zerosPassedThrough = _mm256_add_epi32(hits, endsAtZero);
+}
+#endif
+
+std::string readFile(const std::string& path){
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr<<"Error: Could not open file "<<path<<std::endl;
+        return "";
+    }
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+// Simulates up to FLEET_LANES logs at once and prints the counts of each one.
+// Moves are stored step-major (structure of arrays), so step i of every lane is one
+// contiguous row; lanes whose log has ended are padded with R0 and masked out.
+void runFleetBatch(const std::vector<std::string>& paths, size_t first){
+    size_t laneCount = std::min<size_t>(FLEET_LANES, paths.size() - first);
+    std::vector<std::string> logs(laneCount);
+    for (size_t lane = 0; lane < laneCount; lane++) logs[lane] = readFile(paths[first + lane]);
+
+    std::vector<char> directions;
+    std::vector<int> deltas, active;
+    std::vector<size_t> cursors(laneCount, 0);
+    for (bool anyLeft = true; anyLeft; ) {
+        anyLeft = false;
+        size_t row = directions.size();
+        directions.resize(row + FLEET_LANES, 'R');
+        deltas.resize(row + FLEET_LANES, 0);
+        active.resize(row + FLEET_LANES, 0);
+        for (size_t lane = 0; lane < laneCount; lane++) {
+            const std::string& log = logs[lane];
+            if (nextInstruction(log, cursors[lane], log.size(), directions[row + lane], deltas[row + lane])) {
+                active[row + lane] = 1;
+                anyLeft = true;
+            }
+        }
+    }
+    size_t steps = directions.size() / FLEET_LANES - 1;
+
+    int positions[FLEET_LANES], part1Counts[FLEET_LANES] = {}, part2Counts[FLEET_LANES] = {};
+    std::fill(positions, positions + FLEET_LANES, 50);
+#ifdef __AVX2__
+    // active holds 0 or 1, so masking it with a comparison gives a 0/1 count
+    for (int half = 0; half < FLEET_LANES; half += 8) {
+        __m256i position = _mm256_set1_epi32(50);
+        __m256i part1 = _mm256_setzero_si256(), part2 = _mm256_setzero_si256();
+        for (size_t step = 0; step < steps; step++) {
+            size_t offset = step * FLEET_LANES + half;
+            __m128i directionBytes = _mm_loadl_epi64((const __m128i*)&directions[offset]);
+            __m256i left = _mm256_cmpeq_epi32(_mm256_cvtepu8_epi32(directionBytes), _mm256_set1_epi32('L'));
+            __m256i delta = _mm256_loadu_si256((const __m256i*)&deltas[offset]);
+            __m256i isActive = _mm256_loadu_si256((const __m256i*)&active[offset]);
+            __m256i zerosPassedThrough;
+            turnDial8<DIAL_POSITIONS>(position, delta, left, zerosPassedThrough);
+            __m256i endedAtZero = _mm256_and_si256(isActive, _mm256_cmpeq_epi32(position, _mm256_setzero_si256()));
+            part1 = _mm256_add_epi32(part1, endedAtZero);
+            part2 = _mm256_add_epi32(part2, _mm256_add_epi32(endedAtZero, zerosPassedThrough));
+        }
+        _mm256_storeu_si256((__m256i*)&positions[half], position);
+        _mm256_storeu_si256((__m256i*)&part1Counts[half], part1);
+        _mm256_storeu_si256((__m256i*)&part2Counts[half], part2);
+    }
+#else
+    for (size_t step = 0; step < steps; step++) {
+        const char* direction = &directions[step * FLEET_LANES];
+        const int* delta = &deltas[step * FLEET_LANES];
+        const int* isActive = &active[step * FLEET_LANES];
+        for (int lane = 0; lane < FLEET_LANES; lane++) {
+            auto [newState, zerosPassedThrough] = turnDial<DIAL_POSITIONS>(positions[lane], delta[lane], direction[lane]);
+            int endedAtZero = isActive[lane] & (newState == 0);
+            positions[lane] = newState;
+            part1Counts[lane] += endedAtZero;
+            part2Counts[lane] += endedAtZero + zerosPassedThrough;
+        }
+    }
+#endif
+
+    for (size_t lane = 0; lane < laneCount; lane++) {
+        std::cout<<paths[first + lane]<<": Part 1 Answer: "<<part1Counts[lane]
+                 <<", Part 2 Answer: "<<part2Counts[lane]<<"\n";
+    }
+}
+
+// Log paths come from the command line, or one per line on stdin when none are given
+void solveFleet(std::vector<std::string> paths){
+    if (paths.empty()) {
+        std::string path;
+        while (std::getline(std::cin, path)) {
+            if (!path.empty()) paths.push_back(path);
+        }
+    }
+    for (size_t first = 0; first < paths.size(); first += FLEET_LANES) runFleetBatch(paths, first);
+}
+
+// Follow mode
+// Everything needed to resume counting a log: how far into the file we got and the
+// dial/counters at that point.
+struct FollowState {
+    long long offset = 0;
+    int currentState = 50;
+    long long part1Count = 0, part2Count = 0;
+};
+
+// Fills state from the checkpoint only when all of it parses; a missing checkpoint means a
+// fresh start, a damaged one is reported and ignored so the log is counted from the beginning
+bool loadState(const std::string& path, FollowState& state){
+    std::ifstream file(path);
+    if (!file) return false;
+    FollowState loaded;
+    if (!(file>>loaded.offset>>loaded.currentState>>loaded.part1Count>>loaded.part2Count)
+        || loaded.offset < 0 || loaded.currentState < 0 || loaded.currentState >= DIAL_POSITIONS) {
+        std::cerr<<"Warning: ignoring damaged checkpoint "<<path<<", starting from the beginning of the log"<<std::endl;
+        return false;
+    }
+    state = loaded;
+    return true;
+}
+
+// Written to a temporary file first so a crash never leaves a half-written checkpoint
+void saveState(const std::string& path, const FollowState& state){
+    std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath);
+        file<<state.offset<<" "<<state.currentState<<" "<<state.part1Count<<" "<<state.part2Count<<"\n";
+    }
+    std::rename(temporaryPath.c_str(), path.c_str());
+}
+
+// Applies every complete line appended since state.offset; a trailing partial line is
+// left for the next poll.
+void applyAppended(const std::string& logPath, FollowState& state){
+    std::ifstream file(logPath, std::ios::binary);
+    if (!file) return;
+    file.seekg(0, std::ios::end);
+    long long size = file.tellg();
+    if (size < state.offset) {
+        std::cerr<<"Log "<<logPath<<" shrank, starting over"<<std::endl;
+        state = FollowState();
+    }
+    if (size == state.offset) return;
+
+    std::string text(size - state.offset, '\0');
+    file.seekg(state.offset);
+    file.read(&text[0], text.size());
+    size_t complete = text.rfind('\n');
+    if (complete == std::string::npos) return;
+
+    size_t i = 0;
+    char direction;
+    int delta;
+    while (nextInstruction(text, i, complete, direction, delta)) {
+        auto [newState, zerosPassedThrough] = turnDial<DIAL_POSITIONS>(state.currentState, delta, direction);
+        state.currentState = newState;
+        state.part1Count += (newState == 0);
+        state.part2Count += (newState == 0) + zerosPassedThrough;
+    }
+    state.offset += complete + 1;
+}
+
+// Polls the log for new lines forever, printing the running totals and checkpointing
+// them every intervalSeconds
+void followLog(const std::string& logPath, const std::string& statePath, double intervalSeconds){
+    FollowState state;
+    if (!statePath.empty() && loadState(statePath, state)) {
+        std::cout<<"Resuming "<<logPath<<" at byte "<<state.offset<<std::endl;
+    }
+
+    auto interval = std::chrono::duration<double>(intervalSeconds);
+    auto nextReport = std::chrono::steady_clock::now();
+    while (true) {
+        applyAppended(logPath, state);
+        auto now = std::chrono::steady_clock::now();
+        if (now >= nextReport) {
+            std::cout<<"Part 1 Answer: "<<state.part1Count<<", Part 2 Answer: "<<state.part2Count<<std::endl;
+            if (!statePath.empty()) saveState(statePath, state);
+            nextReport = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval);
+        }
+        std::this_thread::sleep_for(std::min(interval, std::chrono::duration<double>(0.2)));
+    }
+}
+
+// Benchmark mode
+// Times mover0x434C49434B against turnDial on a random log of the given length
+void runBenchmark(int moveCount){
+    std::mt19937 rng(2025);
+    std::uniform_int_distribution<int> deltaDist(0, 999);
+    std::vector<char> directions(moveCount);
+    std::vector<int> deltas(moveCount);
+    for (int i = 0; i < moveCount; i++) {
+        directions[i] = (rng() & 1) ? 'R' : 'L';
+        deltas[i] = deltaDist(rng);
+    }
+
+    auto timeKernel = [&](const char* name, auto kernel){
+        auto start = std::chrono::steady_clock::now();
+        int state = 50;
+        long long part1Count = 0, part2Count = 0;
+        for (int i = 0; i < moveCount; i++) {
+            auto [newState, zerosPassedThrough] = kernel(state, deltas[i], directions[i]);
+            state = newState;
+            part1Count += (state == 0);
+            part2Count += (state == 0) + zerosPassedThrough;
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout<<name<<": "<<elapsed.count() / moveCount<<" ns/move"
+                 <<" (Part 1: "<<part1Count<<", Part 2: "<<part2Count<<")\n";
+    };
+
+    timeKernel("mover0x434C49434B", mover0x434C49434B);
+    timeKernel("turnDial<100>     ", turnDial<DIAL_POSITIONS>);
+}
+
+int main(int argc, char* argv[]){
+    // Usage: ./day1 [--parallel [threads] | --benchmark [moves]] < input
+    //        ./day1 --fleet [logs...]
+    //        ./day1 --follow log [--interval seconds] [--state checkpoint]
+    if (argc > 2 && std::string(argv[1]) == "--follow") {
+        double intervalSeconds = 5;
+        std::string statePath;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            std::string option = argv[i];
+            if (option == "--interval") intervalSeconds = std::stod(argv[i + 1]);
+            else if (option == "--state") statePath = argv[i + 1];
+        }
+        followLog(argv[2], statePath, intervalSeconds);
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--fleet") {
+        solveFleet(std::vector<std::string>(argv + 2, argv + argc));
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+        runBenchmark((argc > 2) ? std::stoi(argv[2]) : 10000000);
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--parallel") {
+        unsigned threadCount = (argc > 2) ? std::stoul(argv[2]) : std::thread::hardware_concurrency();
+        solveParallel(std::max(1u, threadCount));
+        return 0;
+    }
+
     char direction;
     int number, part1Count=0, part2Count=0, currentState = 50;
     while(std::cin>>direction>>number){
         // Use the new method that counts zeros passed through during rotation
-        auto [newState, zerosPassedThrough] = mover0x434C49434B(currentState, number, direction);
+        auto [newState, zerosPassedThrough] = turnDial<DIAL_POSITIONS>(currentState, number, direction);
         currentState = newState;
         
         // std::cout<<"Moving:"<<direction<<number<<"->"<<currentState;
@@ -4,6 +4,14 @@
 #include <algorithm>
 #include <map>
 #include <set>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <random>
+#ifdef __AVX512F__
+#include <immintrin.h>
+#endif
 
 #define ll long long
 
@@ -51,33 +59,356 @@ bool isSilly2(ll num){
     return false;
 }
 
+// Integer-only version of isSilly/isSilly2.
+// An L-digit number repeats a p-digit block exactly when it is a multiple of
+// 1 + 10^p + 10^(2p) + ... (L/p terms), so the string checks become divisibility tests.
+// Those multipliers are odd, which lets each test be a multiply by the inverse mod 2^64
+// and a compare instead of a division: n is a multiple of d iff n * inverse(d) <= (2^64-1)/d.
+typedef unsigned long long ull;
+
+const int MAX_DIGITS = 19;
+
+struct DivisorTest {
+    ull inverse = 1, limit = 0; // the default never matches a non-zero number
+};
+
+struct RepeatTables {
+    ull powers[MAX_DIGITS + 1];
+    DivisorTest twice[MAX_DIGITS + 1];  // block repeated exactly twice (Part 1)
+    DivisorTest any[MAX_DIGITS + 1][2]; // block of length/q for each prime q dividing the length (Part 2)
+};
+
+DivisorTest makeDivisorTest(ull divisor){
+    DivisorTest test;
+    test.inverse = divisor;
+    for (int i = 0; i < 5; i++) test.inverse *= 2 - divisor * test.inverse;
+    test.limit = ~0ULL / divisor;
+    return test;
+}
+
+// A block repeated any number of times is also a (longer) block repeated a prime number of
+// times, so Part 2 only needs the periods length/q for the primes q dividing the length;
+// below 20 digits there are at most two of them.
+RepeatTables buildRepeatTables(){
+    RepeatTables t;
+    t.powers[0] = 1;
+    for (int i = 1; i <= MAX_DIGITS; i++) t.powers[i] = t.powers[i - 1] * 10;
+    auto multiplier = [&](int length, int period){
+        ull m = 0;
+        for (int i = 0; i < length; i += period) m = m * t.powers[period] + 1;
+        return m;
+    };
+    for (int length = 2; length <= MAX_DIGITS; length++) {
+        if (length % 2 == 0) t.twice[length] = makeDivisorTest(multiplier(length, length / 2));
+        int slot = 0;
+        for (int q = 2; q <= length; q++) {
+            bool prime = true;
+            for (int f = 2; f * f <= q; f++) prime = prime && (q % f != 0);
+            if (prime && length % q == 0) t.any[length][slot++] = makeDivisorTest(multiplier(length, length / q));
+        }
+    }
+    return t;
+}
+
+const RepeatTables REPEAT_TABLES = buildRepeatTables();
+
+// Number of decimal digits in num (num >= 0, 0 has one digit), from its bit width and one table lookup
+int digitCount(ll num){
+    int bits = 64 - __builtin_clzll((ull)num | 1);
+    int guess = (bits * 1233) >> 12;
+    return std::max(1, guess + ((ull)num >= REPEAT_TABLES.powers[guess]));
+}
+
+inline bool divides(const DivisorTest& test, ull num){
+    return num * test.inverse <= test.limit;
+}
+
+// Same answer as isSilly, without allocating
+bool isRepeatedTwice(ll num){
+    return num > 0 && divides(REPEAT_TABLES.twice[digitCount(num)], num);
+}
+
+// Same answer as isSilly2, without allocating
+bool isRepeated(ll num){
+    if (num <= 0) return false;
+    const DivisorTest* tests = REPEAT_TABLES.any[digitCount(num)];
+    return divides(tests[0], num) | divides(tests[1], num);
+}
+
+// Batch form of isRepeatedTwice/isRepeated for filtering arbitrary ID streams.
+// With AVX-512 each group of BATCH_LANES IDs is checked by one pass of 8-wide vector
+// instructions: leading-zero count for the digit count, table lookups, 64-bit multiply and
+// unsigned compare. Leftovers, and builds without AVX-512, use the scalar path.
+const int BATCH_LANES = 8;
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__) && defined(__AVX512CD__) && defined(__AVX512BW__) && defined(__AVX512VL__)
+// RepeatTables split into 32-entry columns, so an entry per lane is two in-register
+// permutes and a blend rather than a gather (which is microcoded and slow on many cores)
+struct BatchColumns {
+    alignas(64) ull powers[32] = {};
+    alignas(64) ull twiceInverse[32] = {}, twiceLimit[32] = {};
+    alignas(64) ull anyInverse[2][32] = {}, anyLimit[2][32] = {};
+};
+
+BatchColumns buildBatchColumns(){
+    BatchColumns c;
+    for (int length = 0; length <= MAX_DIGITS; length++) {
+        c.powers[length] = REPEAT_TABLES.powers[length];
+        c.twiceInverse[length] = REPEAT_TABLES.twice[length].inverse;
+        c.twiceLimit[length] = REPEAT_TABLES.twice[length].limit;
+        for (int slot = 0; slot < 2; slot++) {
+            c.anyInverse[slot][length] = REPEAT_TABLES.any[length][slot].inverse;
+            c.anyLimit[slot][length] = REPEAT_TABLES.any[length][slot].limit;
+        }
+    }
+    return c;
+}
+
+const BatchColumns BATCH_COLUMNS = buildBatchColumns();
+
+inline __m512i lookupColumn(const ull* column, __m512i index){
+    __m512i low = _mm512_permutex2var_epi64(_mm512_load_si512(column), index, _mm512_load_si512(column + 8));
+    __m512i high = _mm512_permutex2var_epi64(_mm512_load_si512(column + 16), index, _mm512_load_si512(column + 24));
+    return _mm512_mask_blend_epi64(_mm512_cmpge_epu64_mask(index, _mm512_set1_epi64(16)), low, high);
+}
+#endif
+
+void matchRepeatedBatch(const ll* ids, size_t count, unsigned char* twice, unsigned char* any){
+    size_t i = 0;
+#if defined(__AVX512F__) && defined(__AVX512DQ__) && defined(__AVX512CD__) && defined(__AVX512BW__) && defined(__AVX512VL__)
+    const BatchColumns& c = BATCH_COLUMNS;
+    const __m512i one = _mm512_set1_epi64(1);
+    for (; i + BATCH_LANES <= count; i += BATCH_LANES) {
+        __m512i num = _mm512_loadu_si512(ids + i);
+        __m512i bits = _mm512_sub_epi64(_mm512_set1_epi64(64), _mm512_lzcnt_epi64(_mm512_or_si512(num, one)));
+        __m512i guess = _mm512_srli_epi64(_mm512_mullo_epi64(bits, _mm512_set1_epi64(1233)), 12);
+        __mmask8 above = _mm512_cmpge_epu64_mask(num, lookupColumn(c.powers, guess));
+        __m512i digits = _mm512_mask_add_epi64(guess, above, guess, one);
+
+        auto divides = [&](const ull* inverse, const ull* limit){
+            __m512i product = _mm512_mullo_epi64(num, lookupColumn(inverse, digits));
+            return _mm512_cmple_epu64_mask(product, lookupColumn(limit, digits));
+        };
+        __mmask8 positive = _mm512_cmpgt_epi64_mask(num, _mm512_setzero_si512());
+        __mmask8 twiceMask = positive & divides(c.twiceInverse, c.twiceLimit);
+        __mmask8 anyMask = positive & (divides(c.anyInverse[0], c.anyLimit[0]) | divides(c.anyInverse[1], c.anyLimit[1]));
+        _mm_storel_epi64((__m128i*)(twice + i), _mm_maskz_set1_epi8(twiceMask, 1));
+        _mm_storel_epi64((__m128i*)(any + i), _mm_maskz_set1_epi8(anyMask, 1));
+    }
+#endif
+    for (; i < count; i++) {
+        twice[i] = isRepeatedTwice(ids[i]);
+        any[i] = isRepeated(ids[i]);
+    }
+}
+
+// Sum of the length-digit numbers in [first, last] that are one period-digit block
+// repeated length/period times. Those numbers are block * (1 + 10^period + 10^(2*period) + ...),
+// so the qualifying blocks form a contiguous run and their sum is an arithmetic series.
+__int128 sumRepeated(ll first, ll last, int length, int period){
+    __int128 multiplier = 0, blockEnd = 1;
+    for (int i = 0; i < period; i++) blockEnd *= 10;
+    for (int i = 0; i < length; i += period) multiplier = multiplier * blockEnd + 1;
+
+    __int128 lowBlock = std::max(blockEnd / 10, (first + multiplier - 1) / multiplier);
+    __int128 highBlock = std::min(blockEnd - 1, last / multiplier);
+    if (lowBlock > highBlock) return 0;
+    return multiplier * ((lowBlock + highBlock) * (highBlock - lowBlock + 1) / 2);
+}
+
+// Part 1 for the length-digit IDs in [first, last]: a block repeated exactly twice
+__int128 sumPart1ForLength(ll first, ll last, int length){
+    return (length % 2 == 0) ? sumRepeated(first, last, length, length / 2) : 0;
+}
+
+// Part 2 for the length-digit IDs in [first, last].
+// An ID repeating a block of p digits also repeats every block whose length is a multiple
+// of p, so the sums are turned into sums over the *smallest* repeating block
+// (inclusion-exclusion over the divisors) before being added up.
+__int128 sumPart2ForLength(ll first, ll last, int length){
+    __int128 sum = 0;
+    std::map<int, __int128> exactPeriodSum;
+    for (int period = 1; period < length; period++){
+        if (length % period != 0) continue;
+        __int128 exact = sumRepeated(first, last, length, period);
+        for (const auto& [smaller, smallerSum] : exactPeriodSum){
+            if (period % smaller == 0) exact -= smallerSum;
+        }
+        exactPeriodSum[period] = exact;
+        sum += exact;
+    }
+    return sum;
+}
+
 // Part 1 solution
 ll solvePart1(ll first, ll last) {
     std::cout<<"\nSearching between:"<<first<<" "<<last;
-    ll sum = 0;
-    for (ll i = first; i<=last; i++){
-        if (isSilly(i)){
-            std::cout<<"\nFound:"<<i;
-            sum = sum + i;
-        }
+    __int128 sum = 0;
+    for (int length = digitCount(first); length <= digitCount(last); length++){
+        sum += sumPart1ForLength(first, last, length);
     }
-    return sum;
+    return (ll)sum;
 }
 
 // Part 2 solution
 ll solvePart2(ll first, ll last) {
     std::cout<<"\nSearching between:"<<first<<" "<<last;
-    ll sum = 0;
-    for (ll i = first; i<=last; i++){
-        if (isSilly2(i)){
-            std::cout<<"\nFound:"<<i;
-            sum = sum + i;
+    __int128 sum = 0;
+    for (int length = digitCount(first); length <= digitCount(last); length++){
+        sum += sumPart2ForLength(first, last, length);
+    }
+    return (ll)sum;
+}
+
+// Threaded mode
+// One unit of work: the IDs of a single digit count inside one input range
+struct SubRange {
+    ll first, last;
+    int length;
+};
+
+// Per-worker task queue; the owner takes from the back, idle workers steal from the front
+struct WorkQueue {
+    std::mutex lock;
+    std::deque<size_t> tasks;
+};
+
+// Splits every range at its digit-count boundaries, deals the pieces round-robin into
+// per-thread deques and lets idle threads steal. Both parts are evaluated for each piece
+// in the same visit, and results are kept per piece and added up in piece order, so the
+// totals do not depend on which thread ran what.
+void solveThreaded(const std::vector<std::pair<ll, ll>>& ranges, unsigned threadCount) {
+    std::vector<SubRange> pieces;
+    for (const auto& range : ranges) {
+        for (int length = digitCount(range.first); length <= digitCount(range.second); length++) {
+            ll low = std::max(range.first, (ll)REPEAT_TABLES.powers[length - 1]);
+            ll high = (length < MAX_DIGITS) ? std::min(range.second, (ll)REPEAT_TABLES.powers[length] - 1) : range.second;
+            pieces.push_back({low, high, length});
         }
     }
-    return sum;
+
+    std::vector<WorkQueue> queues(threadCount);
+    for (size_t task = 0; task < pieces.size(); task++) queues[task % threadCount].tasks.push_back(task);
+
+    std::vector<std::pair<__int128, __int128>> results(pieces.size());
+    auto takeTask = [&](unsigned self, size_t& task) {
+        for (unsigned k = 0; k < threadCount; k++) {
+            WorkQueue& queue = queues[(self + k) % threadCount];
+            std::lock_guard<std::mutex> guard(queue.lock);
+            if (queue.tasks.empty()) continue;
+            if (k == 0) {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+            } else {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+            }
+            return true;
+        }
+        return false;
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned self = 0; self < threadCount; self++) {
+        workers.emplace_back([&, self] {
+            size_t task;
+            while (takeTask(self, task)) {
+                const SubRange& piece = pieces[task];
+                results[task] = {sumPart1ForLength(piece.first, piece.last, piece.length),
+                                 sumPart2ForLength(piece.first, piece.last, piece.length)};
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+
+    __int128 p1 = 0, p2 = 0;
+    for (const auto& [part1, part2] : results) {
+        p1 += part1;
+        p2 += part2;
+    }
+    std::cout << "Part 1 Answer: " << (ll)p1 << "\nPart 2 Answer: " << (ll)p2 << std::endl;
+}
+
+// Sums the IDs read from stdin (one per line) that match each part, using the batch predicate
+void filterIds() {
+    std::vector<ll> ids;
+    ll id;
+    while (std::cin >> id) ids.push_back(id);
+
+    std::vector<unsigned char> twice(ids.size()), any(ids.size());
+    matchRepeatedBatch(ids.data(), ids.size(), twice.data(), any.data());
+    ll p1 = 0, p2 = 0;
+    for (size_t i = 0; i < ids.size(); i++) {
+        p1 += ids[i] * twice[i];
+        p2 += ids[i] * any[i];
+    }
+    std::cout << "Part 1 Answer: " << p1 << "\nPart 2 Answer: " << p2 << std::endl;
 }
 
-int main() {
+// Times the string predicates against the integer and batch ones on random IDs
+void runBenchmark(size_t count) {
+    std::mt19937_64 rng(2025);
+    std::vector<ll> ids(count);
+    const RepeatTables& t = REPEAT_TABLES;
+    for (ll& id : ids) {
+        // Spread the IDs over all digit counts, with a share of real matches mixed in
+        int digits = 2 + rng() % 17;
+        id = (ll)(t.powers[digits - 1] + rng() % (9 * t.powers[digits - 1]));
+        if (rng() % 4 == 0 && digits % 2 == 0) {
+            ull block = t.powers[digits / 2 - 1] + rng() % (9 * t.powers[digits / 2 - 1]);
+            id = (ll)(block * (t.powers[digits / 2] + 1));
+        }
+    }
+
+    auto timeIt = [&](const char* name, auto matchAll){
+        auto start = std::chrono::steady_clock::now();
+        auto [p1, p2] = matchAll();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << name << ": " << elapsed.count() / count << " ns/ID (Part 1: " << p1 << ", Part 2: " << p2 << ")\n";
+    };
+
+    timeIt("isSilly/isSilly2         ", [&]{
+        ull p1 = 0, p2 = 0;
+        for (ll id : ids) {
+            p1 += isSilly(id) ? id : 0;
+            p2 += isSilly2(id) ? id : 0;
+        }
+        return std::make_pair(p1, p2);
+    });
+    timeIt("isRepeatedTwice/isRepeated", [&]{
+        ull p1 = 0, p2 = 0;
+        for (ll id : ids) {
+            p1 += id * isRepeatedTwice(id);
+            p2 += id * isRepeated(id);
+        }
+        return std::make_pair(p1, p2);
+    });
+    timeIt("matchRepeatedBatch        ", [&]{
+        std::vector<unsigned char> twice(count), any(count);
+        matchRepeatedBatch(ids.data(), count, twice.data(), any.data());
+        ull p1 = 0, p2 = 0;
+        for (size_t i = 0; i < count; i++) {
+            p1 += ids[i] * twice[i];
+            p2 += ids[i] * any[i];
+        }
+        return std::make_pair(p1, p2);
+    });
+}
+
+int main(int argc, char* argv[]) {
+    // Usage: ./day2 < ranges
+    //        ./day2 --threads [count] < ranges
+    //        ./day2 --filter < ids
+    //        ./day2 --benchmark [count]
+    if (argc > 1 && std::string(argv[1]) == "--filter") {
+        filterIds();
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+        runBenchmark((argc > 2) ? std::stoull(argv[2]) : 1000000);
+        return 0;
+    }
+
     // Read input into a vector to process it twice
     std::vector<std::pair<ll, ll>> ranges;
     ll a, b;
@@ -88,6 +419,12 @@ int main() {
             ranges.push_back({a, b});
         }
     }
+
+    if (argc > 1 && std::string(argv[1]) == "--threads") {
+        unsigned threadCount = (argc > 2) ? std::stoul(argv[2]) : std::thread::hardware_concurrency();
+        solveThreaded(ranges, std::max(1u, threadCount));
+        return 0;
+    }
     
     // Solve Part 1
     ll p1 = 0;
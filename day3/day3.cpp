@@ -5,92 +5,246 @@
 #include <map>
 #include <set>
 #include <fstream>
+#include <cstdio>
+#include <cstring>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Largest number that can be formed by keeping k of the n digits of a bank in order.
+// One pass with a monotonic stack: each digit evicts the smaller digits kept before it
+// while there are still digits we are allowed to drop, and once k digits are kept a
+// digit that evicts nothing is dropped itself. Banks with at most k digits are used whole.
+// The result must fit in a long long, so k is at most 18.
+inline long long selectMaxDigits(const char* bank, size_t n, int k, char* kept) {
+    long long canDrop = (long long)n - k;
+    int size = 0;
+    for (size_t i = 0; i < n; ++i) {
+        char c = bank[i];
+        while (canDrop > 0 && size > 0 && kept[size - 1] < c) {
+            size--;
+            canDrop--;
+        }
+        if (size < k) {
+            kept[size++] = c;
+        } else {
+            canDrop--;
+        }
+    }
+
+    long long joltage = 0;
+    for (int i = 0; i < size; ++i) {
+        joltage = joltage * 10 + (kept[i] - '0');
+    }
+    return joltage;
+}
+
+// K known at compile time: the stack lives in registers/on the stack and the loop is specialised
+template <int K>
+long long selectMaxDigits(const std::string& bank) {
+    char kept[K];
+    return selectMaxDigits(bank.data(), bank.size(), K, kept);
+}
+
+// K chosen at run time
+long long selectMaxDigits(const std::string& bank, int k) {
+    std::vector<char> kept(k);
+    return selectMaxDigits(bank.data(), bank.size(), k, kept.data());
+}
 
 // Part 1 solution
+// Best pair of batteries per bank; a bank needs at least two of them
 int solvePart1(const std::vector<std::string>& lines) {
     int result = 0;
     
     for (const std::string& line : lines) {
-        // Process each line of input
-        int maxJoltage = 0;
-        
-        // Check all possible pairs of positions
-        for (size_t i = 0; i < line.length(); ++i) {
-            for (size_t j = i + 1; j < line.length(); ++j) {
-                // Calculate the joltage from this pair
-                int joltage = (line[i] - '0') * 10 + (line[j] - '0');
-                
-                // Update max joltage if this is higher
-                maxJoltage = std::max(maxJoltage, joltage);
-            }
+        if (line.length() >= 2) {
+            result += selectMaxDigits<2>(line);
         }
-        
-        // Add this bank's max joltage to the result
-        result += maxJoltage;
     }
     
     return result;
 }
 
 // Part 2 solution
+// Best 12 batteries per bank
 long long solvePart2(const std::vector<std::string>& lines) {
     long long result = 0;
     
     for (const std::string& line : lines) {
-        // Process each line of input
-        
-        // We need to select exactly 12 batteries (digits) from each bank
-        // to form the largest possible number
-        
-        // If the line has exactly 12 digits, use all of them
-        if (line.length() == 12) {
-            long long joltage = 0;
-            for (char c : line) {
-                joltage = joltage * 10 + (c - '0');
-            }
-            result += joltage;
-            continue;
+        result += selectMaxDigits<12>(line);
+    }
+    
+    return result;
+}
+
+// Batched mode
+// BATCH_LANES banks of the same length are packed column by column into a transposed
+// byte matrix (column c holds digit c of every bank), so one 32-byte load reads the same
+// position of all banks. Banks that cannot be grouped (ragged lengths, leftovers, banks
+// longer than 255 digits or shorter than k) go through the scalar engine.
+const int BATCH_LANES = 32;
+const size_t MAX_BATCHED_LENGTH = 255;
+
+#ifdef __AVX2__
+// Greedy selection on all lanes at once: digit j of the answer is the first maximum in
+// columns [start, n - k + j], and the next search starts right after it. Positions fit
+// in a byte because batched banks are at most MAX_BATCHED_LENGTH long.
+void selectMaxDigitsBatch(const char* transposed, int n, int k, long long* joltages) {
+    __m256i start = _mm256_setzero_si256();
+    __m256i chosen[18];
+    int minStart = 0;
+    for (int j = 0; j < k; ++j) {
+        __m256i best = _mm256_set1_epi8('0' - 1);
+        __m256i bestPos = start;
+        for (int col = minStart; col <= n - k + j; ++col) {
+            __m256i digits = _mm256_loadu_si256((const __m256i*)(transposed + (size_t)col * BATCH_LANES));
+            __m256i column = _mm256_set1_epi8((char)col);
+            __m256i active = _mm256_cmpeq_epi8(_mm256_max_epu8(column, start), column);
+            __m256i better = _mm256_and_si256(active, _mm256_cmpgt_epi8(digits, best));
+            best = _mm256_blendv_epi8(best, digits, better);
+            bestPos = _mm256_blendv_epi8(bestPos, column, better);
+        }
+        chosen[j] = best;
+        start = _mm256_add_epi8(bestPos, _mm256_set1_epi8(1));
+
+        // Every lane has advanced past the previous pick, so columns before the smallest start are done
+        alignas(32) unsigned char starts[BATCH_LANES];
+        _mm256_store_si256((__m256i*)starts, start);
+        minStart = *std::min_element(starts, starts + BATCH_LANES);
+    }
+
+    std::fill(joltages, joltages + BATCH_LANES, 0);
+    for (int j = 0; j < k; ++j) {
+        alignas(32) char digits[BATCH_LANES];
+        _mm256_store_si256((__m256i*)digits, chosen[j]);
+        for (int lane = 0; lane < BATCH_LANES; ++lane) {
+            joltages[lane] = joltages[lane] * 10 + (digits[lane] - '0');
         }
-        
-        // If the line has more than 12 digits, we need to remove (n - 12) digits
-        // to get exactly 12 digits
-        int digitsToRemove = line.length() - 12;
-        
-        // Use a stack to keep track of the digits we want to keep
-        std::vector<char> stack;
-        
-        for (char c : line) {
-            // While we still have digits to remove and the current digit is larger than the last digit in the stack,
-            // we remove the last digit from the stack
-            while (digitsToRemove > 0 && !stack.empty() && stack.back() < c) {
-                stack.pop_back();
-                digitsToRemove--;
+    }
+}
+#endif
+
+// Both parts, with equal-length banks grouped into batches for the SIMD kernel
+void solveBatched(const std::vector<std::string>& lines) {
+    int part1Result = 0;
+    long long part2Result = 0;
+    auto solveScalar = [&](const std::string& bank) {
+        if (bank.length() >= 2) part1Result += selectMaxDigits<2>(bank);
+        part2Result += selectMaxDigits<12>(bank);
+    };
+
+#ifdef __AVX2__
+    std::map<size_t, std::vector<const std::string*>> byLength;
+    for (const std::string& bank : lines) {
+        if (bank.length() >= 12 && bank.length() <= MAX_BATCHED_LENGTH) {
+            byLength[bank.length()].push_back(&bank);
+        } else {
+            solveScalar(bank);
+        }
+    }
+
+    std::vector<char> transposed(MAX_BATCHED_LENGTH * BATCH_LANES);
+    long long joltages[BATCH_LANES];
+    for (const auto& [length, banks] : byLength) {
+        size_t i = 0;
+        for (; i + BATCH_LANES <= banks.size(); i += BATCH_LANES) {
+            for (int lane = 0; lane < BATCH_LANES; ++lane) {
+                const std::string& bank = *banks[i + lane];
+                for (size_t col = 0; col < length; ++col) transposed[col * BATCH_LANES + lane] = bank[col];
             }
-            
-            // Add the current digit to the stack
-            stack.push_back(c);
+            selectMaxDigitsBatch(transposed.data(), (int)length, 2, joltages);
+            for (long long joltage : joltages) part1Result += (int)joltage;
+            selectMaxDigitsBatch(transposed.data(), (int)length, 12, joltages);
+            for (long long joltage : joltages) part2Result += joltage;
         }
-        
-        // If we still have digits to remove, remove them from the end
-        while (digitsToRemove > 0) {
-            stack.pop_back();
-            digitsToRemove--;
+        for (; i < banks.size(); ++i) solveScalar(*banks[i]);
+    }
+#else
+    for (const std::string& bank : lines) solveScalar(bank);
+#endif
+
+    std::cout << "\nPart 1 Answer: " << part1Result << std::endl;
+    std::cout << "Part 2 Answer: " << part2Result << std::endl;
+}
+
+// Streaming mode
+// Selection state for the bank being read, built digit by digit without knowing the bank's
+// length in advance: best[j] is the largest j-digit number picked (in order) from the digits
+// seen so far, and a new digit d can only improve it as best[j-1] * 10 + d. Part 1 is
+// best[2] and Part 2 is best[12] of the same table, so one pass answers both.
+struct BankScanner {
+    static const int K = 12;
+    long long best[K + 1] = {};
+    long long seen = 0;
+
+    void feed(const char* digits, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            if (digits[i] < '0' || digits[i] > '9') continue;
+            int d = digits[i] - '0';
+            int top = (int)std::min<long long>(seen + 1, K);
+            for (int j = top; j >= 1; --j) {
+                best[j] = std::max(best[j], best[j - 1] * 10 + d);
+            }
+            seen++;
         }
-        
-        // Calculate the joltage from the selected digits
-        long long joltage = 0;
-        for (char c : stack) {
-            joltage = joltage * 10 + (c - '0');
+    }
+
+    // Adds the finished bank to the totals with the same rules as solvePart1/solvePart2
+    void finish(int& part1Result, long long& part2Result) {
+        if (seen >= 2) part1Result += (int)best[2];
+        part2Result += best[std::min<long long>(seen, K)];
+        *this = BankScanner();
+    }
+};
+
+// Reads stdin through one fixed-size buffer and splits banks at newlines in place, so memory
+// stays constant however large the input or any single bank is
+void solveStreaming() {
+    static char buffer[1 << 16];
+    int part1Result = 0;
+    long long part2Result = 0;
+    BankScanner scanner;
+    bool pending = false;
+
+    size_t bytes;
+    while ((bytes = std::fread(buffer, 1, sizeof(buffer), stdin)) > 0) {
+        const char* cursor = buffer;
+        const char* end = buffer + bytes;
+        while (cursor < end) {
+            const char* newline = (const char*)std::memchr(cursor, '\n', end - cursor);
+            const char* lineEnd = newline ? newline : end;
+            scanner.feed(cursor, lineEnd - cursor);
+            pending = true;
+            if (newline) {
+                scanner.finish(part1Result, part2Result);
+                pending = false;
+            }
+            cursor = lineEnd + 1;
         }
-        
-        // Add this bank's joltage to the result
-        result += joltage;
     }
-    
-    return result;
+    if (pending) scanner.finish(part1Result, part2Result);
+
+    std::cout << "\nPart 1 Answer: " << part1Result << std::endl;
+    std::cout << "Part 2 Answer: " << part2Result << std::endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Usage: ./day3 [--digits k | --batched | --stream] < input
+    if (argc > 1 && std::string(argv[1]) == "--stream") {
+        solveStreaming();
+        return 0;
+    }
+    
+    // The joltage is a long long, so at most 18 batteries fit
+    if (argc > 2 && std::string(argv[1]) == "--digits") {
+        int k = std::stoi(argv[2]);
+        if (k < 1 || k > 18) {
+            std::cerr << "Error: the number of batteries must be between 1 and 18" << std::endl;
+            return 1;
+        }
+    }
+    
     // Read input into memory
     std::vector<std::string> lines;
     std::string line;
@@ -99,6 +253,22 @@ int main() {
         lines.push_back(line);
     }
     
+    // Any other number of batteries per bank goes through the run-time engine
+    if (argc > 2 && std::string(argv[1]) == "--digits") {
+        int k = std::stoi(argv[2]);
+        long long result = 0;
+        for (const std::string& bank : lines) {
+            result += selectMaxDigits(bank, k);
+        }
+        std::cout << "\nAnswer for " << k << " batteries: " << result << std::endl;
+        return 0;
+    }
+    
+    if (argc > 1 && std::string(argv[1]) == "--batched") {
+        solveBatched(lines);
+        return 0;
+    }
+    
     // Solve both parts
     int part1Result = solvePart1(lines);
     long long part2Result = solvePart2(lines);
@@ -5,6 +5,9 @@
 #include <map>
 #include <set>
 #include <fstream>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 // Part 1 solution
 int solvePart1(const std::vector<std::string>& lines) {
@@ -44,62 +47,297 @@ int solvePart1(const std::vector<std::string>& lines) {
 }
 
 // Part 2 solution
+// Peels the grid round by round without rescanning it. Neighbour counts are computed once
+// on a copy padded with an empty border (so no bounds checks); removing a roll decrements
+// its 8 neighbours, and a roll whose count drops below 4 is queued for the next round.
+// Rolls queued for the same round are removed together, as in the full-grid rescan.
 long long solvePart2(const std::vector<std::string>& lines) {
     int rows = lines.size();
     int cols = lines[0].size();
+    int width = cols + 2;
     long long result = 0;
     
-    // Create a mutable copy of the grid
-    std::vector<std::string> grid = lines;
+    std::vector<char> present((size_t)(rows + 2) * width, 0);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            present[(size_t)(i + 1) * width + j + 1] = (lines[i][j] == '@');
+        }
+    }
     
-    // Define the 8 possible directions (including diagonals)
-    const int dx[] = {-1, -1, -1, 0, 0, 1, 1, 1};
-    const int dy[] = {-1, 0, 1, -1, 1, -1, 0, 1};
+    const int offsets[] = {-width - 1, -width, -width + 1, -1, 1, width - 1, width, width + 1};
     
-    // Continue removing paper rolls until no more can be removed
-    bool removedAny = true;
-    while (removedAny) {
-        removedAny = false;
-        
-        // Find all accessible paper rolls in the current state
-        std::vector<std::pair<int, int>> accessibleRolls;
+    std::vector<unsigned char> adjacentRolls(present.size(), 0);
+    std::vector<char> queued(present.size(), 0);
+    std::vector<size_t> round;
+    for (size_t cell = width; cell < present.size() - width; ++cell) {
+        if (!present[cell]) continue;
+        for (int offset : offsets) {
+            adjacentRolls[cell] += present[cell + offset];
+        }
+        if (adjacentRolls[cell] < 4) {
+            queued[cell] = 1;
+            round.push_back(cell);
+        }
+    }
+    
+    std::vector<size_t> nextRound;
+    while (!round.empty()) {
+        for (size_t cell : round) {
+            present[cell] = 0;
+        }
+        result += round.size();
         
-        for (int i = 0; i < rows; ++i) {
-            for (int j = 0; j < cols; ++j) {
-                // Check if current position is a paper roll
-                if (grid[i][j] == '@') {
-                    // Count adjacent paper rolls
-                    int adjacentRolls = 0;
-                    for (int dir = 0; dir < 8; ++dir) {
-                        int ni = i + dx[dir];
-                        int nj = j + dy[dir];
-                        
-                        // Check if the adjacent position is within bounds and has a paper roll
-                        if (ni >= 0 && ni < rows && nj >= 0 && nj < cols && grid[ni][nj] == '@') {
-                            adjacentRolls++;
-                        }
-                    }
-                    
-                    // If there are fewer than 4 adjacent paper rolls, this roll can be accessed
-                    if (adjacentRolls < 4) {
-                        accessibleRolls.push_back({i, j});
-                    }
+        for (size_t cell : round) {
+            for (int offset : offsets) {
+                size_t neighbour = cell + offset;
+                if (present[neighbour] && --adjacentRolls[neighbour] < 4 && !queued[neighbour]) {
+                    queued[neighbour] = 1;
+                    nextRound.push_back(neighbour);
                 }
             }
         }
+        round.swap(nextRound);
+        nextRound.clear();
+    }
+    
+    return result;
+}
+
+// Bitboard mode
+// The grid is stored as bits, 64 cells per word, with an empty border: column c of row r
+// is bit c + 1 of row r + 1, and rows 0 and rows + 1 plus the bits outside the grid stay 0.
+typedef unsigned long long Word;
+
+struct Bitboard {
+    int rows = 0, cols = 0, words = 0; // words per row
+    std::vector<Word> bits;
+    
+    Word* row(int r) { return &bits[(size_t)r * words]; }
+    const Word* row(int r) const { return &bits[(size_t)r * words]; }
+};
+
+// Reads the grid one line at a time, so only the bits are ever held in memory
+Bitboard readBitboard(std::istream& in) {
+    Bitboard board;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (board.rows == 0) {
+            board.cols = line.size();
+            board.words = (board.cols + 2 + 63) / 64;
+            board.bits.assign(board.words, 0);
+        }
+        board.bits.resize(board.bits.size() + board.words, 0);
+        Word* row = board.row(++board.rows);
+        for (int j = 0; j < board.cols && j < (int)line.size(); ++j) {
+            if (line[j] == '@') row[(j + 1) / 64] |= Word(1) << ((j + 1) % 64);
+        }
+    }
+    board.bits.resize(board.bits.size() + board.words, 0);
+    return board;
+}
+
+// Marks the rolls of a row that have fewer than 4 neighbouring rolls. The 8 neighbours of
+// 64 cells are the rows above/at/below shifted by one column either way; a carry-save
+// adder tree sums them bit-sliced, and a sum below 4 is one with neither the fours nor
+// the eights bit set.
+void accessibleInRow(const Word* above, const Word* row, const Word* below, int words, Word* out) {
+    const Word* rows[3] = {above, row, below};
+    int last = words - 1;
+    for (int w = 0; w <= last; ++w) {
+        Word in[8];
+        int n = 0;
+        for (int k = 0; k < 3; ++k) {
+            const Word* x = rows[k];
+            Word west = (x[w] << 1) | (w > 0 ? x[w - 1] >> 63 : 0);
+            Word east = (x[w] >> 1) | (w < last ? x[w + 1] << 63 : 0);
+            in[n++] = west;
+            in[n++] = east;
+            if (k != 1) in[n++] = x[w];
+        }
+        
+        // Full adders over the 8 inputs: ones (weight 1), then the carries (weight 2) summed again
+        Word c1 = (in[0] & in[1]) | (in[2] & (in[0] ^ in[1]));
+        Word s1 = in[0] ^ in[1] ^ in[2];
+        Word c2 = (in[3] & in[4]) | (in[5] & (in[3] ^ in[4]));
+        Word s2 = in[3] ^ in[4] ^ in[5];
+        Word c3 = in[6] & in[7];
+        Word s3 = in[6] ^ in[7];
+        Word c4 = (s1 & s2) | (s3 & (s1 ^ s2));
+        Word c5 = (c1 & c2) | (c3 & (c1 ^ c2));
+        Word c6 = (c1 ^ c2 ^ c3) & c4;
+        out[w] = rows[1][w] & ~(c5 | c6);
+    }
+}
+
+// Part 1 is the first round; Part 2 keeps removing rounds of accessible rolls. A row can
+// only change if it or a row next to it lost rolls in the previous round, so only those
+// rows are recomputed.
+void solveBitboard(std::istream& in) {
+    Bitboard board = readBitboard(in);
+    std::vector<Word> removable(board.bits.size(), 0);
+    std::vector<char> dirty(board.rows + 2, 1);
+    long long part1Result = -1, part2Result = 0;
+    
+    std::vector<int> changedRows;
+    do {
+        changedRows.clear();
+        long long removed = 0;
+        for (int r = 1; r <= board.rows; ++r) {
+            if (!dirty[r]) continue;
+            Word* out = &removable[(size_t)r * board.words];
+            accessibleInRow(board.row(r - 1), board.row(r), board.row(r + 1), board.words, out);
+            long long count = 0;
+            for (int w = 0; w < board.words; ++w) count += __builtin_popcountll(out[w]);
+            if (count > 0) changedRows.push_back(r);
+            removed += count;
+        }
         
-        // Remove all accessible paper rolls
-        for (const auto& pos : accessibleRolls) {
-            grid[pos.first][pos.second] = '.';
-            result++;
-            removedAny = true;
+        std::fill(dirty.begin(), dirty.end(), 0);
+        for (int r : changedRows) {
+            Word* row = board.row(r);
+            const Word* out = &removable[(size_t)r * board.words];
+            for (int w = 0; w < board.words; ++w) row[w] &= ~out[w];
+            dirty[r - 1] = dirty[r] = dirty[r + 1] = 1;
+        }
+        
+        if (part1Result < 0) part1Result = removed;
+        part2Result += removed;
+    } while (!changedRows.empty());
+    
+    std::cout << "\nPart 1 Answer: " << part1Result << std::endl;
+    std::cout << "Part 2 Answer: " << part2Result << std::endl;
+}
+
+// Banded mode
+// Reusable thread barrier (std::barrier needs C++20)
+class Barrier {
+public:
+    explicit Barrier(int count) : count(count) {}
+    
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        int current = generation;
+        if (++arrived == count) {
+            arrived = 0;
+            generation++;
+            released.notify_all();
+        } else {
+            released.wait(lock, [&] { return generation != current; });
         }
     }
     
-    return result;
+private:
+    std::mutex mutex;
+    std::condition_variable released;
+    int count, arrived = 0, generation = 0;
+};
+
+// A horizontal band of rows owned by one thread. The halos are private copies of the
+// neighbouring bands' edge rows as they were at the start of the round, because those
+// bands update their rows in place while this one is still reading them.
+struct Band {
+    int first, last; // owned rows, inclusive
+    std::vector<Word> haloAbove, haloBelow;
+    bool haloAboveChanged = true, haloBelowChanged = true;
+    std::vector<char> changed; // owned rows that lost rolls in the previous round
+    long long removed = 0;
+};
+
+// One round on one band, in place: rows are walked top to bottom keeping a copy of the
+// previous row as it was before this round, so only two rows of scratch space are needed.
+void peelBand(Bitboard& board, Band& band) {
+    int words = board.words;
+    std::vector<Word> previous = band.haloAbove, out(words);
+    std::vector<char> changedNow(band.changed.size(), 0);
+    band.removed = 0;
+    for (int r = band.first; r <= band.last; ++r) {
+        int i = r - band.first;
+        bool dirty = band.changed[i] ||
+                     (r == band.first ? band.haloAboveChanged : band.changed[i - 1]) ||
+                     (r == band.last ? band.haloBelowChanged : band.changed[i + 1]);
+        Word* row = board.row(r);
+        long long count = 0;
+        if (dirty) {
+            const Word* below = (r == band.last) ? band.haloBelow.data() : board.row(r + 1);
+            accessibleInRow(previous.data(), row, below, words, out.data());
+            for (int w = 0; w < words; ++w) count += __builtin_popcountll(out[w]);
+        }
+        std::copy(row, row + words, previous.begin());
+        if (count > 0) {
+            for (int w = 0; w < words; ++w) row[w] &= ~out[w];
+            changedNow[i] = 1;
+            band.removed += count;
+        }
+    }
+    band.changed.swap(changedNow);
+}
+
+// Refreshes a band's halos from its neighbours once every band has finished the round
+void exchangeHalos(const Bitboard& board, std::vector<Band>& bands, size_t b) {
+    Band& band = bands[b];
+    const Word* above = board.row(band.first - 1);
+    const Word* below = board.row(band.last + 1);
+    band.haloAbove.assign(above, above + board.words);
+    band.haloBelow.assign(below, below + board.words);
+    band.haloAboveChanged = (b > 0) && bands[b - 1].changed.back();
+    band.haloBelowChanged = (b + 1 < bands.size()) && bands[b + 1].changed.front();
+}
+
+// Peels the bitboard with one band of rows per thread. Every thread sums the per-band
+// removal counts in band order after each round, and all stop together on a round in
+// which no band removed anything.
+void solveBanded(std::istream& in, int threadCount) {
+    Bitboard board = readBitboard(in);
+    threadCount = std::max(1, std::min(threadCount, board.rows));
+    
+    std::vector<Band> bands(threadCount);
+    for (int b = 0; b < threadCount; ++b) {
+        bands[b].first = 1 + (long long)board.rows * b / threadCount;
+        bands[b].last = (long long)board.rows * (b + 1) / threadCount;
+        bands[b].changed.assign(bands[b].last - bands[b].first + 1, 1);
+    }
+    for (int b = 0; b < threadCount; ++b) {
+        exchangeHalos(board, bands, b);
+        bands[b].haloAboveChanged = bands[b].haloBelowChanged = true;
+    }
+    
+    Barrier barrier(threadCount);
+    std::vector<long long> roundTotals;
+    std::vector<std::thread> workers;
+    for (int b = 0; b < threadCount; ++b) {
+        workers.emplace_back([&, b] {
+            while (true) {
+                peelBand(board, bands[b]);
+                barrier.wait();
+                long long total = 0;
+                for (const Band& band : bands) total += band.removed;
+                exchangeHalos(board, bands, b);
+                if (b == 0) roundTotals.push_back(total);
+                barrier.wait();
+                if (total == 0) break;
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    
+    long long part2Result = 0;
+    for (long long total : roundTotals) part2Result += total;
+    std::cout << "\nPart 1 Answer: " << roundTotals.front() << std::endl;
+    std::cout << "Part 2 Answer: " << part2Result << std::endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Usage: ./day4 [--bitboard | --threads [count]] < input
+    if (argc > 1 && std::string(argv[1]) == "--threads") {
+        int threadCount = (argc > 2) ? std::stoi(argv[2]) : (int)std::thread::hardware_concurrency();
+        solveBanded(std::cin, threadCount);
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--bitboard") {
+        solveBitboard(std::cin);
+        return 0;
+    }
+    
     // Read input into memory
     std::vector<std::string> lines;
     std::string line;
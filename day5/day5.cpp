@@ -5,7 +5,14 @@
 #include <map>
 #include <set>
 #include <sstream>
+#include <thread>
 #include <fstream>
+#include <cstring>
+#include <cctype>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // Structure to represent a range of fresh ingredient IDs
 struct Range {
@@ -20,88 +27,75 @@ struct Range {
     }
 };
 
-// Parse input and return the fresh ranges
-std::vector<Range> parseRanges(const std::string& filename) {
-    std::ifstream file(filename);
-    std::string line;
+// Everything in the input file: the fresh ranges and the available IDs
+struct Inventory {
     std::vector<Range> freshRanges;
-    
-    // Parse input to get fresh ingredient ID ranges
-    while (std::getline(file, line)) {
-        // Empty line separates ranges from available IDs
-        if (line.empty()) {
-            break; // We only need the ranges
-        }
-        
-        // Parse range in format "start-end"
-        size_t dashPos = line.find('-');
-        if (dashPos != std::string::npos) {
-            long long start = std::stoll(line.substr(0, dashPos));
-            long long end = std::stoll(line.substr(dashPos + 1));
-            freshRanges.emplace_back(start, end);
-        }
+    std::vector<long long> availableIds;
+};
+
+// Reads the unsigned number starting at p, stopping at the first non-digit
+inline long long parseNumber(const char*& p, const char* end) {
+    long long value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p++ - '0');
     }
-    
-    return freshRanges;
+    return value;
 }
 
-// Parse input and return the available IDs
-std::vector<long long> parseAvailableIds(const std::string& filename) {
-    std::ifstream file(filename);
-    std::string line;
-    std::vector<long long> availableIds;
-    bool parsingRanges = true;
-    
-    // Skip the ranges section
-    while (std::getline(file, line)) {
-        if (line.empty()) {
-            parsingRanges = false;
-            break;
-        }
+// Loads the whole file in one pass: it is memory-mapped and parsed in place, ranges
+// ("start-end") up to the first empty line and one available ID per line after it
+Inventory loadInventory(const std::string& filename) {
+    Inventory inventory;
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return inventory;
     }
-    
-    // Parse available IDs
-    while (std::getline(file, line)) {
-        availableIds.push_back(std::stoll(line));
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return inventory;
     }
+    size_t size = info.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Error: Could not map file " << filename << std::endl;
+        return inventory;
+    }
+    madvise(mapping, size, MADV_SEQUENTIAL);
     
-    return availableIds;
-}
-
-// Part 1 solution
-void solvePart1(const std::string& filename) {
-    std::vector<Range> freshRanges = parseRanges(filename);
-    std::vector<long long> availableIds = parseAvailableIds(filename);
-    
-    // Count fresh ingredients
-    int freshCount = 0;
-    for (long long id : availableIds) {
-        bool isFresh = false;
-        for (const Range& range : freshRanges) {
-            if (range.contains(id)) {
-                isFresh = true;
-                break;
+    const char* p = static_cast<const char*>(mapping);
+    const char* end = p + size;
+    bool parsingRanges = true;
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!lineEnd) lineEnd = end;
+        bool blank = (p == lineEnd) || (*p == '\r' && p + 1 == lineEnd);
+        
+        if (parsingRanges) {
+            // Empty line separates ranges from available IDs
+            if (blank) {
+                parsingRanges = false;
+            } else {
+                long long start = parseNumber(p, lineEnd);
+                if (p < lineEnd && *p == '-') {
+                    ++p;
+                    inventory.freshRanges.emplace_back(start, parseNumber(p, lineEnd));
+                }
             }
+        } else if (!blank) {
+            inventory.availableIds.push_back(parseNumber(p, lineEnd));
         }
-        if (isFresh) {
-            freshCount++;
-        }
+        p = lineEnd + 1;
     }
     
-    std::cout << "\nPart 1 Answer: " << freshCount << std::endl;
+    munmap(mapping, size);
+    return inventory;
 }
 
-// Part 2 solution - find all unique fresh ingredient IDs
-void solvePart2(const std::string& filename) {
-    std::vector<Range> freshRanges = parseRanges(filename);
-    
-    // Debug output
-    // std::cout << "Parsed " << freshRanges.size() << " ranges:" << std::endl;
-    // for (const auto& range : freshRanges) {
-    //     std::cout << "  " << range.start << "-" << range.end << std::endl;
-    // }
-    
-    // Merge overlapping ranges
+// Sorts the ranges by start and merges overlapping or adjacent ones
+std::vector<Range> mergeRanges(std::vector<Range> freshRanges) {
     std::sort(freshRanges.begin(), freshRanges.end(), 
               [](const Range& a, const Range& b) { return a.start < b.start; });
     
@@ -124,12 +118,271 @@ void solvePart2(const std::string& filename) {
         }
     }
     
-    // Debug output
-    // std::cout << "Merged into " << mergedRanges.size() << " ranges:" << std::endl;
-    // for (const auto& range : mergedRanges) {
-    //     std::cout << "  " << range.start << "-" << range.end << std::endl;
-    // }
+    return mergedRanges;
+}
+
+// Parallel version of mergeRanges as a sample sort:
+//  1. Splitters picked from a sorted sample cut the start values into one bucket per thread.
+//  2. Each thread counts how many of its slice of the input land in every bucket; prefix
+//     sums of the counts give every (thread, bucket) pair its own slot in a second buffer,
+//     so the scatter needs no locking and the buffer is the only extra copy.
+//  3. Each thread sorts and merges its bucket in place.
+//  4. Stitching walks the bucket boundaries: the leading ranges of a bucket that touch the
+//     last range kept so far are folded into it (a long range can swallow whole buckets),
+//     and the survivors are moved down to close the gaps.
+// Equal starts always share a bucket, so the result is the same as mergeRanges.
+std::vector<Range> mergeRangesParallel(const std::vector<Range>& freshRanges, int threadCount) {
+    size_t n = freshRanges.size();
+    threadCount = std::max(1, std::min<int>(threadCount, n / 4096));
+    if (threadCount == 1) return mergeRanges(freshRanges);
+    
+    std::vector<long long> sample;
+    size_t sampleSize = 64 * threadCount;
+    for (size_t i = 0; i < sampleSize; ++i) {
+        sample.push_back(freshRanges[i * n / sampleSize].start);
+    }
+    std::sort(sample.begin(), sample.end());
+    std::vector<long long> splitters;
+    for (int b = 1; b < threadCount; ++b) {
+        splitters.push_back(sample[b * sampleSize / threadCount]);
+    }
+    auto bucketOf = [&](long long start) {
+        return std::upper_bound(splitters.begin(), splitters.end(), start) - splitters.begin();
+    };
+    
+    auto runThreads = [threadCount](auto work) {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threadCount; ++t) workers.emplace_back(work, t);
+        for (std::thread& worker : workers) worker.join();
+    };
+    
+    // counts[t][b]: ranges from thread t's slice that belong in bucket b
+    std::vector<std::vector<size_t>> counts(threadCount, std::vector<size_t>(threadCount, 0));
+    runThreads([&](int t) {
+        for (size_t i = n * t / threadCount; i < n * (t + 1) / threadCount; ++i) {
+            ++counts[t][bucketOf(freshRanges[i].start)];
+        }
+    });
+    
+    // Turn the counts into write offsets, bucket-major so each bucket is contiguous
+    std::vector<size_t> bucketBegin(threadCount + 1, 0);
+    size_t offset = 0;
+    for (int b = 0; b < threadCount; ++b) {
+        bucketBegin[b] = offset;
+        for (int t = 0; t < threadCount; ++t) {
+            size_t count = counts[t][b];
+            counts[t][b] = offset;
+            offset += count;
+        }
+    }
+    bucketBegin[threadCount] = n;
+    
+    std::vector<Range> buckets(n, Range(0, 0));
+    runThreads([&](int t) {
+        std::vector<size_t>& next = counts[t];
+        for (size_t i = n * t / threadCount; i < n * (t + 1) / threadCount; ++i) {
+            buckets[next[bucketOf(freshRanges[i].start)]++] = freshRanges[i];
+        }
+    });
     
+    // Sort and merge every bucket in place, keeping its merged length
+    std::vector<size_t> mergedCount(threadCount, 0);
+    runThreads([&](int b) {
+        Range* first = buckets.data() + bucketBegin[b];
+        Range* last = buckets.data() + bucketBegin[b + 1];
+        if (first == last) return;
+        std::sort(first, last, [](const Range& a, const Range& c) { return a.start < c.start; });
+        Range* out = first;
+        for (Range* current = first + 1; current != last; ++current) {
+            if (current->start <= out->end + 1) {
+                out->end = std::max(out->end, current->end);
+            } else {
+                *++out = *current;
+            }
+        }
+        mergedCount[b] = out - first + 1;
+    });
+    
+    // Stitch the boundaries and compact the buckets towards the front
+    size_t kept = 0;
+    for (int b = 0; b < threadCount; ++b) {
+        Range* first = buckets.data() + bucketBegin[b];
+        size_t count = mergedCount[b], skip = 0;
+        if (kept > 0) {
+            Range& last = buckets[kept - 1];
+            while (skip < count && first[skip].start <= last.end + 1) {
+                last.end = std::max(last.end, first[skip].end);
+                ++skip;
+            }
+        }
+        std::memmove(buckets.data() + kept, first + skip, (count - skip) * sizeof(Range));
+        kept += count - skip;
+    }
+    buckets.resize(kept, Range(0, 0));
+    return buckets;
+}
+
+// Lookup structure over merged (disjoint, sorted) ranges.
+// The range ends are stored in Eytzinger order (a binary search tree laid out breadth
+// first, node k has children 2k and 2k+1), so a search walks down with one comparison and
+// no branch per level and the top levels share a few cache lines. An ID is fresh when the
+// first range ending at or after it also starts at or before it.
+class IntervalIndex {
+public:
+    // Keeps a reference to mergedRanges for the batch path, so they must outlive the index
+    explicit IntervalIndex(const std::vector<Range>& mergedRanges)
+        : ranges(mergedRanges), ends(mergedRanges.size() + 1), starts(mergedRanges.size() + 1) {
+        size_t next = 0;
+        build(1, next);
+    }
+    
+    bool contains(long long id) const {
+        size_t k = 1;
+        while (k < ends.size()) {
+            k = 2 * k + (ends[k] < id);
+        }
+        // Undo the final run of right turns plus one left turn to land on the answer
+        k >>= __builtin_ffsll(~k);
+        return k != 0 && starts[k] <= id;
+    }
+    
+    // Batch path: sorts the IDs and walks them together with the ranges in one merge pass
+    long long countFresh(std::vector<long long> ids) const {
+        std::sort(ids.begin(), ids.end());
+        long long freshCount = 0;
+        size_t r = 0;
+        for (long long id : ids) {
+            while (r < ranges.size() && ranges[r].end < id) ++r;
+            if (r == ranges.size()) break;
+            freshCount += (ranges[r].start <= id);
+        }
+        return freshCount;
+    }
+    
+private:
+    // Fills the tree in order: an in-order walk of the Eytzinger layout visits sorted ranks
+    void build(size_t k, size_t& next) {
+        if (k >= ends.size()) return;
+        build(2 * k, next);
+        ends[k] = ranges[next].end;
+        starts[k] = ranges[next].start;
+        ++next;
+        build(2 * k + 1, next);
+    }
+    
+    const std::vector<Range>& ranges;
+    std::vector<long long> ends, starts; // slot 0 unused
+};
+
+// Set of fresh IDs that changes over time, kept as disjoint ranges in a std::map from
+// start to end. Touching or overlapping ranges are merged on insert, removal splits the
+// ranges it cuts, and the number of covered IDs (the Part 2 answer) is updated as ranges
+// come and go rather than recounted.
+class FreshRangeSet {
+public:
+    void insert(const Range& range) {
+        long long start = range.start, end = range.end;
+        auto it = firstTouching(start, 1);
+        while (it != ranges.end() && it->first <= end + 1) {
+            start = std::min(start, it->first);
+            end = std::max(end, it->second);
+            covered -= it->second - it->first + 1;
+            it = ranges.erase(it);
+        }
+        ranges.emplace(start, end);
+        covered += end - start + 1;
+    }
+    
+    void erase(const Range& range) {
+        auto it = firstTouching(range.start, 0);
+        while (it != ranges.end() && it->first <= range.end) {
+            long long start = it->first, end = it->second;
+            covered -= end - start + 1;
+            it = ranges.erase(it);
+            if (start < range.start) {
+                ranges.emplace(start, range.start - 1);
+                covered += range.start - start;
+            }
+            if (end > range.end) {
+                ranges.emplace(range.end + 1, end);
+                covered += end - range.end;
+                break;
+            }
+        }
+    }
+    
+    bool contains(long long id) const {
+        auto it = ranges.upper_bound(id);
+        return it != ranges.begin() && std::prev(it)->second >= id;
+    }
+    
+    long long totalFresh() const {
+        return covered;
+    }
+    
+private:
+    // First range that overlaps, or is within `gap` of, a range starting at start
+    std::map<long long, long long>::iterator firstTouching(long long start, long long gap) {
+        auto it = ranges.upper_bound(start);
+        if (it != ranges.begin() && std::prev(it)->second + gap >= start) --it;
+        return it;
+    }
+    
+    std::map<long long, long long> ranges;
+    long long covered = 0;
+};
+
+// Live mode: starts from the file's ranges, then applies one command per line from stdin:
+//   add a-b, remove a-b, check id, total
+void runLive(const Inventory& inventory) {
+    FreshRangeSet fresh;
+    for (const Range& range : inventory.freshRanges) {
+        fresh.insert(range);
+    }
+    
+    std::string command, argument;
+    while (std::cin >> command) {
+        if (command == "total") {
+            std::cout << fresh.totalFresh() << "\n";
+            continue;
+        }
+        std::cin >> argument;
+        const char* p = argument.c_str();
+        const char* end = p + argument.size();
+        long long first = parseNumber(p, end);
+        long long last = (p < end && *p == '-') ? parseNumber(++p, end) : first;
+        if (command == "add") {
+            fresh.insert(Range(first, last));
+        } else if (command == "remove") {
+            fresh.erase(Range(first, last));
+        } else if (command == "check") {
+            std::cout << (fresh.contains(first) ? "fresh" : "spoiled") << "\n";
+        } else {
+            std::cerr << "Unknown command: " << command << std::endl;
+        }
+    }
+}
+
+// Part 1 solution
+void solvePart1(const Inventory& inventory, const std::vector<Range>& mergedRanges, bool batch) {
+    IntervalIndex index(mergedRanges);
+    const std::vector<long long>& availableIds = inventory.availableIds;
+    
+    // Count fresh ingredients
+    long long freshCount = 0;
+    if (batch) {
+        freshCount = index.countFresh(availableIds);
+    } else {
+        for (long long id : availableIds) {
+            freshCount += index.contains(id);
+        }
+    }
+    
+    std::cout << "\nPart 1 Answer: " << freshCount << std::endl;
+}
+
+// Part 2 solution - find all unique fresh ingredient IDs
+void solvePart2(const std::vector<Range>& mergedRanges) {
     // Count total unique IDs in all merged ranges
     long long totalFreshIds = 0;
     for (const Range& range : mergedRanges) {
@@ -140,17 +393,45 @@ void solvePart2(const std::string& filename) {
 }
 
 int main(int argc, char* argv[]) {
+    // Usage: ./day5 [input] [--batch | --live < commands] [--threads [count]]
     std::string filename = "example.in";
+    bool batch = false, live = false;
+    int threadCount = 1;
     
-    if (argc > 1) {
-        filename = argv[1];
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--batch") {
+            batch = true;
+        } else if (arg == "--live") {
+            live = true;
+        } else if (arg == "--threads") {
+            if (i + 1 < argc && std::isdigit((unsigned char)argv[i + 1][0])) {
+                threadCount = std::stoi(argv[++i]);
+            } else {
+                threadCount = (int)std::thread::hardware_concurrency();
+            }
+        } else {
+            filename = arg;
+        }
+    }
+    
+    Inventory inventory = loadInventory(filename);
+    
+    if (live) {
+        runLive(inventory);
+        return 0;
     }
     
+    // Both parts work from the same merged ranges, sorted and merged once
+    std::vector<Range> mergedRanges = (threadCount > 1)
+        ? mergeRangesParallel(inventory.freshRanges, threadCount)
+        : mergeRanges(inventory.freshRanges);
+    
     // Solve part 1
-    solvePart1(filename);
+    solvePart1(inventory, mergedRanges, batch);
     
     // Solve part 2
-    solvePart2(filename);
+    solvePart2(mergedRanges);
     
     return 0;
 }
@@ -6,6 +6,18 @@
 #include <set>
 #include <fstream>
 #include <sstream>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 // Function to solve a single math problem
 long long solveProblem(const std::vector<long long>& numbers, char operation) {
@@ -256,9 +268,323 @@ void solvePart2(const std::vector<std::string>& lines = {}) {
 }
 
 
+// Column block kernel: reads COLUMN_LANES adjacent columns from every row, returns a mask
+// of the columns holding anything other than a space, and writes each column's vertical
+// number (digits top to bottom, the last row is the operators and holds none).
+const int COLUMN_LANES = 32;
+
+// Bytes [col, col + COLUMN_LANES) of a row, padded with spaces past its end
+inline const char* columnBlock(std::string_view row, size_t col, char* padded) {
+    if (col + COLUMN_LANES <= row.size()) return row.data() + col;
+    std::memset(padded, ' ', COLUMN_LANES);
+    if (col < row.size()) std::memcpy(padded, row.data() + col, row.size() - col);
+    return padded;
+}
+
+#ifdef __AVX2__
+// value = value * 10 + digit on four 64-bit lanes, only where isDigit is set
+inline __m256i accumulateLanes(__m256i value, __m128i digits, __m128i isDigit) {
+    __m256i shifted = _mm256_add_epi64(_mm256_slli_epi64(value, 3), _mm256_slli_epi64(value, 1));
+    __m256i next = _mm256_add_epi64(shifted, _mm256_cvtepu8_epi64(digits));
+    return _mm256_blendv_epi8(value, next, _mm256_cvtepi8_epi64(isDigit));
+}
+
+uint32_t accumulateColumns(const std::vector<std::string_view>& rows, size_t col, long long* values) {
+    __m256i lanes[COLUMN_LANES / 4];
+    for (__m256i& lane : lanes) lane = _mm256_setzero_si256();
+    uint32_t occupied = 0;
+    alignas(32) char padded[COLUMN_LANES];
+    
+    for (size_t row = 0; row < rows.size(); ++row) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)columnBlock(rows[row], col, padded));
+        occupied |= ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')));
+        if (row + 1 == rows.size()) break;
+        
+        // Bytes below '0' wrap around, so one unsigned compare keeps just the digits
+        __m256i digits = _mm256_sub_epi8(bytes, _mm256_set1_epi8('0'));
+        __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(9)), digits);
+        if (_mm256_testz_si256(isDigit, isDigit)) continue;
+        digits = _mm256_and_si256(digits, isDigit);
+        
+        __m128i halves[2] = {_mm256_castsi256_si128(digits), _mm256_extracti128_si256(digits, 1)};
+        __m128i masks[2] = {_mm256_castsi256_si128(isDigit), _mm256_extracti128_si256(isDigit, 1)};
+        for (int h = 0; h < 2; ++h) {
+            __m256i* out = lanes + 4 * h;
+            out[0] = accumulateLanes(out[0], halves[h], masks[h]);
+            out[1] = accumulateLanes(out[1], _mm_srli_si128(halves[h], 4), _mm_srli_si128(masks[h], 4));
+            out[2] = accumulateLanes(out[2], _mm_srli_si128(halves[h], 8), _mm_srli_si128(masks[h], 8));
+            out[3] = accumulateLanes(out[3], _mm_srli_si128(halves[h], 12), _mm_srli_si128(masks[h], 12));
+        }
+    }
+    
+    for (int i = 0; i < COLUMN_LANES / 4; ++i) {
+        _mm256_storeu_si256((__m256i*)(values + 4 * i), lanes[i]);
+    }
+    return occupied;
+}
+#else
+uint32_t accumulateColumns(const std::vector<std::string_view>& rows, size_t col, long long* values) {
+    std::fill(values, values + COLUMN_LANES, 0);
+    uint32_t occupied = 0;
+    char padded[COLUMN_LANES];
+    for (size_t row = 0; row < rows.size(); ++row) {
+        const char* bytes = columnBlock(rows[row], col, padded);
+        for (int lane = 0; lane < COLUMN_LANES; ++lane) {
+            char c = bytes[lane];
+            occupied |= (uint32_t)(c != ' ') << lane;
+            if (row + 1 < rows.size() && c >= '0' && c <= '9') {
+                values[lane] = values[lane] * 10 + (c - '0');
+            }
+        }
+    }
+    return occupied;
+}
+#endif
+
+// Column index of a worksheet, built in one pass over column blocks: a bitmap of the
+// columns that hold anything other than a space, and the problems as maximal runs of
+// occupied columns. Both parts are evaluated from it without going back to the bitmap.
+// The rows are views, so a worksheet can cover whole lines or a window of a mapped file.
+struct Worksheet {
+    struct Problem {
+        size_t left, right;
+        char operation;
+    };
+    
+    std::vector<std::string_view> rows;
+    size_t width = 0;
+    std::vector<uint64_t> occupied;
+    std::vector<long long> columnValues; // Part 2 number of every column
+    std::vector<Problem> problems;
+};
+
+Worksheet buildWorksheet(std::vector<std::string_view> rows) {
+    Worksheet sheet;
+    sheet.rows = std::move(rows);
+    const std::vector<std::string_view>& lines = sheet.rows;
+    for (const auto& line : lines) {
+        sheet.width = std::max(sheet.width, line.size());
+    }
+    size_t blocks = (sheet.width + COLUMN_LANES - 1) / COLUMN_LANES;
+    sheet.occupied.assign((blocks + 1) / 2, 0);
+    sheet.columnValues.resize(blocks * COLUMN_LANES);
+    for (size_t b = 0; b < blocks; ++b) {
+        uint32_t mask = accumulateColumns(lines, b * COLUMN_LANES, &sheet.columnValues[b * COLUMN_LANES]);
+        sheet.occupied[b / 2] |= (uint64_t)mask << (b % 2 * COLUMN_LANES);
+    }
+    
+    // Runs of set bits are problems; whole words of ones or zeros are skipped at once
+    std::string_view operationsLine = lines.back();
+    size_t col = 0;
+    while (col < sheet.width) {
+        uint64_t word = sheet.occupied[col / 64] >> (col % 64);
+        if (word == 0) {
+            col = (col / 64 + 1) * 64;
+            continue;
+        }
+        size_t left = col + __builtin_ctzll(word);
+        size_t right = left;
+        while (right + 1 < sheet.width) {
+            uint64_t rest = ~sheet.occupied[(right + 1) / 64] >> ((right + 1) % 64);
+            if (rest != 0) {
+                right += __builtin_ctzll(rest);
+                break;
+            }
+            right = ((right + 1) / 64 + 1) * 64 - 1;
+        }
+        right = std::min(right, sheet.width - 1);
+        
+        // The first operator in the span applies to the whole problem
+        char operation = ' ';
+        for (size_t i = left; i <= right && i < operationsLine.size(); ++i) {
+            if (operationsLine[i] == '+' || operationsLine[i] == '*') {
+                operation = operationsLine[i];
+                break;
+            }
+        }
+        if (operation != ' ') {
+            sheet.problems.push_back({left, right, operation});
+        }
+        col = right + 1;
+    }
+    return sheet;
+}
+
+// Folds one number into a problem's running result; zeros (blank cells) are left out
+inline void applyOperand(long long& result, long long num, char operation) {
+    if (num == 0) return;
+    result = (operation == '*') ? result * num : result + num;
+}
+
+// Part 1 from the index: every row of a problem is one number, read left to right
+long long evaluatePart1(const Worksheet& sheet) {
+    const std::vector<std::string_view>& lines = sheet.rows;
+    std::vector<long long> results;
+    for (const auto& problem : sheet.problems) {
+        results.push_back(problem.operation == '*' ? 1 : 0);
+    }
+    
+    for (size_t row = 0; row + 1 < lines.size(); ++row) {
+        std::string_view line = lines[row];
+        for (size_t p = 0; p < sheet.problems.size(); ++p) {
+            const auto& problem = sheet.problems[p];
+            size_t col = problem.left;
+            size_t end = std::min(problem.right + 1, line.size());
+            while (col < end && line[col] == ' ') ++col;
+            long long num = 0;
+            while (col < end && line[col] >= '0' && line[col] <= '9') {
+                num = num * 10 + (line[col++] - '0');
+            }
+            applyOperand(results[p], num, problem.operation);
+        }
+    }
+    
+    long long grandTotal = 0;
+    for (long long result : results) {
+        grandTotal += result;
+    }
+    return grandTotal;
+}
+
+// Part 2 from the index: every column is one number, already built by the column kernel
+long long evaluatePart2(const Worksheet& sheet) {
+    const std::vector<long long>& columnValues = sheet.columnValues;
+    long long grandTotal = 0;
+    for (const auto& problem : sheet.problems) {
+        long long result = (problem.operation == '*') ? 1 : 0;
+        for (size_t col = problem.left; col <= problem.right; ++col) {
+            applyOperand(result, columnValues[col], problem.operation);
+        }
+        grandTotal += result;
+    }
+    return grandTotal;
+}
+
+// A worksheet file mapped into memory with a view of each row, so very wide inputs are
+// read in place instead of being copied into strings
+class MappedWorksheet {
+public:
+    explicit MappedWorksheet(const char* filename) {
+        int fd = open(filename, O_RDONLY);
+        if (fd < 0) return;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            size = info.st_size;
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) data = static_cast<const char*>(mapping);
+        }
+        close(fd);
+        if (!data) return;
+        
+        const char* p = data;
+        const char* end = data + size;
+        while (p < end) {
+            const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (!lineEnd) lineEnd = end;
+            rows.emplace_back(p, lineEnd - p);
+            width = std::max(width, rows.back().size());
+            p = lineEnd + 1;
+        }
+    }
+    
+    ~MappedWorksheet() {
+        if (data) munmap(const_cast<char*>(data), size);
+    }
+    
+    MappedWorksheet(const MappedWorksheet&) = delete;
+    MappedWorksheet& operator=(const MappedWorksheet&) = delete;
+    
+    const char* data = nullptr;
+    size_t size = 0;
+    size_t width = 0;
+    std::vector<std::string_view> rows;
+};
+
+// Whether column col of the worksheet holds anything other than a space
+inline bool isOccupied(const Worksheet& sheet, size_t col) {
+    return col / 64 < sheet.occupied.size() && (sheet.occupied[col / 64] >> (col % 64) & 1);
+}
+
+// Both answers for the problems that start in columns [first, last). The window's index
+// also covers the column before it, so a problem already open there is left to the window
+// before, and a margin after it, so the problem still open at the window end is evaluated
+// whole; the margin doubles until that problem's closing empty column is inside it.
+std::pair<long long, long long> evaluateWindow(const MappedWorksheet& file, size_t first, size_t last) {
+    size_t from = (first > 0) ? first - 1 : 0;
+    for (size_t margin = COLUMN_LANES; ; margin *= 2) {
+        size_t end = std::min(file.width, last + margin);
+        std::vector<std::string_view> window;
+        for (const auto& row : file.rows) {
+            size_t start = std::min(from, row.size());
+            window.push_back(row.substr(start, end - start));
+        }
+        Worksheet sheet = buildWorksheet(std::move(window));
+        
+        bool closed = end == file.width || !isOccupied(sheet, last - 1 - from);
+        for (size_t col = last; col < end && !closed; ++col) {
+            closed = !isOccupied(sheet, col - from);
+        }
+        if (!closed) continue;
+        
+        std::vector<Worksheet::Problem> owned;
+        for (Worksheet::Problem problem : sheet.problems) {
+            if (problem.left + from >= first && problem.left + from < last) owned.push_back(problem);
+        }
+        sheet.problems.swap(owned);
+        return {evaluatePart1(sheet), evaluatePart2(sheet)};
+    }
+}
+
+// Walks the mapped worksheet in windows of windowWidth columns, handed out to the threads
+// one at a time. Only one window per thread is indexed at any moment, so memory follows
+// the window width times the number of rows rather than the file size.
+void solveMapped(const char* filename, int threadCount, size_t windowWidth = 1 << 16) {
+    MappedWorksheet file(filename);
+    if (file.rows.empty()) {
+        std::cerr << "Error: Could not map file " << filename << std::endl;
+        return;
+    }
+    
+    size_t windowCount = (file.width + windowWidth - 1) / windowWidth;
+    threadCount = std::max(1, std::min<int>(threadCount, windowCount));
+    std::atomic<size_t> nextWindow(0);
+    std::vector<std::pair<long long, long long>> totals(threadCount, {0, 0});
+    
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&, t]() {
+            size_t w;
+            while ((w = nextWindow.fetch_add(1)) < windowCount) {
+                size_t first = w * windowWidth;
+                auto [part1, part2] = evaluateWindow(file, first, std::min(first + windowWidth, file.width));
+                totals[t].first += part1;
+                totals[t].second += part2;
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    
+    long long part1 = 0, part2 = 0;
+    for (const auto& [sum1, sum2] : totals) {
+        part1 += sum1;
+        part2 += sum2;
+    }
+    std::cout << "Part 1 Answer: " << part1 << std::endl;
+    std::cout << "Part 2 Answer: " << part2 << std::endl;
+}
+
 int main(int argc, char* argv[]) {
-    // Check if a file path is provided
-    if (argc > 1) {
+    // Usage: ./day6 [input [part1 | part2 | --mapped [threads]]]
+    // With just the input (or on stdin) both parts come from the column index; naming a part
+    // runs that part's step-by-step solver and prints every problem, and --mapped reads the
+    // file in place one column window at a time
+    if (argc > 2 && std::string(argv[2]) == "--mapped") {
+        int threadCount = (argc > 3) ? std::stoi(argv[3]) : (int)std::thread::hardware_concurrency();
+        solveMapped(argv[1], threadCount);
+        return 0;
+    }
+    
+    if (argc > 2) {
         std::cout << "Opening file: " << argv[1] << std::endl;
         
         // Open the file
@@ -277,17 +603,39 @@ int main(int argc, char* argv[]) {
         }
         
         // Check if we should solve part 1 or part 2
-        if (argc > 2 && std::string(argv[2]) == "part2") {
+        if (std::string(argv[2]) == "part2") {
             // Solve part 2 with the lines we've read
             solvePart2(lines);
         } else {
             // Solve part 1 with the lines we've read
             solvePart1(lines);
         }
-    } else {
-        // No file provided, read from stdin
-        solvePart1();
+        return 0;
     }
     
+    std::ifstream inputFile;
+    if (argc > 1) {
+        inputFile.open(argv[1]);
+        if (!inputFile.is_open()) {
+            std::cerr << "Error: Could not open file " << argv[1] << std::endl;
+            return 1;
+        }
+    }
+    std::istream& in = (argc > 1) ? inputFile : std::cin;
+    
+    std::string line;
+    std::vector<std::string> lines;
+    while (std::getline(in, line)) {
+        lines.push_back(line);
+    }
+    if (lines.empty()) {
+        std::cout << "\nPart 1 Answer: 0 (No input)" << std::endl;
+        return 0;
+    }
+    
+    Worksheet sheet = buildWorksheet(std::vector<std::string_view>(lines.begin(), lines.end()));
+    std::cout << "Part 1 Answer: " << evaluatePart1(sheet) << std::endl;
+    std::cout << "Part 2 Answer: " << evaluatePart2(sheet) << std::endl;
+    
     return 0;
 }
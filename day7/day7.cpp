@@ -5,20 +5,30 @@
 #include <map>
 #include <set>
 #include <fstream>
-#include <queue>
 #include <utility>
 #include <tuple>
 #include <functional>
 
-// Structure to represent a beam
-struct Beam {
-    int row;
-    int col;
-    
-    Beam(int r, int c) : row(r), col(c) {}
-};
+typedef unsigned long long Word;
+const int WORD_BITS = 64;
+
+// The '^' cells of every row as bits: column c is bit c % 64 of word c / 64, and row r's
+// words start at r * words
+std::vector<Word> buildSplitterMasks(const std::vector<std::string>& grid, int cols, int words) {
+    std::vector<Word> masks((size_t)grid.size() * words, 0);
+    for (size_t r = 0; r < grid.size(); ++r) {
+        for (int c = 0; c < cols; ++c) {
+            masks[r * words + c / WORD_BITS] |= (Word)(grid[r][c] == '^') << (c % WORD_BITS);
+        }
+    }
+    return masks;
+}
 
 // Function to simulate beam propagation and count splits (Part 1)
+// The beams of a row are a bitset and all move down together. Beams that meet a splitter
+// (beams & mask) each count one split and continue one column to either side, the rest go
+// straight on, so a row costs a few word operations per 64 columns. Beams that land on the
+// same cell merge, which is why every splitter is counted at most once.
 int simulateBeam(const std::vector<std::string>& grid) {
     int rows = grid.size();
     int cols = grid[0].size();
@@ -40,55 +50,121 @@ int simulateBeam(const std::vector<std::string>& grid) {
     }
     
     std::cout << "Starting position: (" << startRow << ", " << startCol << ")" << std::endl;
+    if (startRow == -1) return 0;
     
-    // Initialize with the beam starting from 'S' and moving downward
-    std::queue<Beam> beams;
-    beams.push(Beam(startRow + 1, startCol)); // Start one row below 'S'
+    int words = (cols + WORD_BITS - 1) / WORD_BITS;
+    std::vector<Word> masks = buildSplitterMasks(grid, cols, words);
+    // Columns that exist in the final word; beams split past the right edge are dropped
+    Word lastWordMask = (cols % WORD_BITS == 0) ? ~0ULL : (1ULL << (cols % WORD_BITS)) - 1;
     
-    // Keep track of visited splitters to avoid counting them multiple times
-    std::set<std::pair<int, int>> visitedSplitters;
+    // Initialize with the beam one row below 'S'
+    std::vector<Word> beams(words, 0), hits(words, 0);
+    beams[startCol / WORD_BITS] |= 1ULL << (startCol % WORD_BITS);
     
     // Count of beam splits
     int splitCount = 0;
     
-    // Process beams until no more beams are left
-    while (!beams.empty()) {
-        Beam current = beams.front();
-        beams.pop();
-        
-        // Check if the beam is out of bounds
-        if (current.row < 0 || current.row >= rows || current.col < 0 || current.col >= cols) {
-            continue;
+    for (int r = startRow + 1; r < rows; ++r) {
+        const Word* mask = &masks[(size_t)r * words];
+        for (int w = 0; w < words; ++w) {
+            hits[w] = beams[w] & mask[w];
+            beams[w] &= ~mask[w];
+            splitCount += __builtin_popcountll(hits[w]);
         }
-        
-        // Check if the beam encounters a splitter
-        if (grid[current.row][current.col] == '^') {
-            // Check if this splitter has been visited before
-            std::pair<int, int> splitterPos = {current.row, current.col};
-            if (visitedSplitters.find(splitterPos) == visitedSplitters.end()) {
-                // Mark the splitter as visited
-                visitedSplitters.insert(splitterPos);
-                
-                // Count this as a split
-                splitCount++;
-                
-                std::cout << "Beam split at position (" << current.row << ", " << current.col << ")" << std::endl;
-                
-                // Create two new beams from the left and right of the splitter
-                beams.push(Beam(current.row + 1, current.col - 1)); // Left beam
-                beams.push(Beam(current.row + 1, current.col + 1)); // Right beam
-            }
-        } else {
-            // Continue the beam downward
-            beams.push(Beam(current.row + 1, current.col));
+        // Split beams move one column left (towards bit 0) and one column right
+        for (int w = 0; w < words; ++w) {
+            Word fromBelow = (w > 0) ? hits[w - 1] >> (WORD_BITS - 1) : 0;
+            Word fromAbove = (w + 1 < words) ? hits[w + 1] << (WORD_BITS - 1) : 0;
+            beams[w] |= (hits[w] << 1) | fromBelow | (hits[w] >> 1) | fromAbove;
         }
+        beams[words - 1] &= lastWordMask;
     }
     
     return splitCount;
 }
 
+// Count types for the timeline DPs. Counts can double at every row with splitters, so
+// long long only holds them for shallow grids; the DPs take the count type as a template
+// parameter, are handed its zero and one, and only need copies, += and +.
+
+// Unsigned integer of Limbs 64-bit limbs (least significant first) stored inline, so adding
+// to a cell never allocates. A carry out of the top limb is lost, so pick enough limbs.
+template <int Limbs>
+struct FixedBigInt {
+    unsigned long long limbs[Limbs] = {};
+    
+    FixedBigInt(unsigned long long value = 0) { limbs[0] = value; }
+    
+    FixedBigInt& operator+=(const FixedBigInt& other) {
+        bool carry = false;
+        for (int i = 0; i < Limbs; ++i) {
+            unsigned long long sum;
+            bool first = __builtin_add_overflow(limbs[i], other.limbs[i], &sum);
+            bool second = __builtin_add_overflow(sum, (unsigned long long)carry, &limbs[i]);
+            carry = first | second;
+        }
+        return *this;
+    }
+    
+    FixedBigInt operator+(const FixedBigInt& other) const {
+        FixedBigInt sum = *this;
+        return sum += other;
+    }
+};
+
+// Prints in decimal by repeatedly dividing a copy by 10^19, one limb at a time from the top
+template <int Limbs>
+std::ostream& operator<<(std::ostream& out, const FixedBigInt<Limbs>& number) {
+    const unsigned long long CHUNK = 10000000000000000000ULL;
+    FixedBigInt<Limbs> rest = number;
+    std::vector<unsigned long long> chunks;
+    bool nonZero = true;
+    while (nonZero) {
+        unsigned __int128 remainder = 0;
+        nonZero = false;
+        for (int i = Limbs - 1; i >= 0; --i) {
+            unsigned __int128 current = (remainder << 64) | rest.limbs[i];
+            rest.limbs[i] = (unsigned long long)(current / CHUNK);
+            remainder = current % CHUNK;
+            nonZero |= rest.limbs[i] != 0;
+        }
+        chunks.push_back((unsigned long long)remainder);
+    }
+    std::string digits = std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;) {
+        std::string chunk = std::to_string(chunks[i]);
+        digits += std::string(19 - chunk.size(), '0') + chunk;
+    }
+    return out << digits;
+}
+
+// Count modulo a run-time modulus below 2^63, so one conditional subtract keeps it reduced
+// and any grid runs at machine-word speed. Every count carries its own modulus.
+struct ModularCount {
+    unsigned long long value;
+    unsigned long long modulus;
+    
+    ModularCount(unsigned long long v, unsigned long long m) : value(v % m), modulus(m) {}
+    
+    ModularCount& operator+=(const ModularCount& other) {
+        value += other.value;
+        if (value >= modulus) value -= modulus;
+        return *this;
+    }
+    
+    ModularCount operator+(const ModularCount& other) const {
+        ModularCount sum = *this;
+        return sum += other;
+    }
+};
+
+std::ostream& operator<<(std::ostream& out, const ModularCount& count) {
+    return out << count.value;
+}
+
 // Function to count the number of unique timelines (Part 2)
-long long countTimelines(const std::vector<std::string>& grid) {
+template <typename Count = long long>
+Count countTimelines(const std::vector<std::string>& grid, const Count& zero = Count(0), const Count& one = Count(1)) {
     int rows = grid.size();
     int cols = grid[0].size();
     
@@ -107,45 +183,54 @@ long long countTimelines(const std::vector<std::string>& grid) {
     }
     
     std::cout << "Starting position: (" << startRow << ", " << startCol << ")" << std::endl;
+    if (startRow == -1) return zero;
     
-    // Create a 2D array to store the number of paths to each position
-    std::vector<std::vector<long long>> pathCount(rows + 1, std::vector<long long>(cols + 2, 0));
+    // Counts only for the row being read and the row being written; live lists the columns
+    // with beams in the current row, so each row costs as much as its beams, not its width.
+    // Column c of the grid is index c + 1, indices 0 and cols + 1 are exits off the sides.
+    std::vector<Count> current(cols + 2, zero), next(cols + 2, zero);
+    std::vector<int> live, nextLive;
+    std::vector<int> stamp(cols + 2, -1); // last row that put column c on nextLive
+    Count totalPaths = zero;
     
-    // Initialize the starting position
-    pathCount[startRow + 1][startCol + 1] = 1;
+    current[startCol + 1] = one;
+    live.push_back(startCol + 1);
     
-    // Process each row from top to bottom
+    // Row r holds the beams on grid row r - 1; the last grid row lets everything through
     for (int r = startRow + 1; r < rows; ++r) {
-        for (int c = 1; c <= cols; ++c) {
-            // Skip if no paths reach this position
-            if (pathCount[r][c] == 0) continue;
+        auto send = [&](int c, const Count& count) {
+            if (c == 0 || c == cols + 1) {
+                // Paths that go out of bounds from the sides
+                totalPaths += count;
+                return;
+            }
+            if (stamp[c] != r) {
+                stamp[c] = r;
+                nextLive.push_back(c);
+            }
+            next[c] += count;
+        };
+        
+        for (int c : live) {
+            Count count = current[c];
+            current[c] = zero;
             
             // If this is a splitter, paths go to both left and right in the next row
             if (grid[r-1][c-1] == '^') {
-                // Left path
-                pathCount[r + 1][c - 1] += pathCount[r][c];
-                
-                // Right path
-                pathCount[r + 1][c + 1] += pathCount[r][c];
+                send(c - 1, count);
+                send(c + 1, count);
             } else {
-                // Continue downward
-                pathCount[r + 1][c] += pathCount[r][c];
+                send(c, count);
             }
         }
+        std::swap(current, next);
+        std::swap(live, nextLive);
+        nextLive.clear();
     }
     
-    // Count paths that reach the bottom row or go out of bounds
-    long long totalPaths = 0;
-    
     // Paths that reach the bottom row
-    for (int c = 1; c <= cols; ++c) {
-        totalPaths += pathCount[rows][c];
-    }
-    
-    // Paths that go out of bounds from the sides
-    for (int r = startRow + 1; r <= rows; ++r) {
-        totalPaths += pathCount[r][0];     // Left edge
-        totalPaths += pathCount[r][cols+1]; // Right edge
+    for (int c : live) {
+        totalPaths += current[c];
     }
     
     std::cout << "Total unique paths (timelines): " << totalPaths << std::endl;
@@ -153,29 +238,66 @@ long long countTimelines(const std::vector<std::string>& grid) {
     return totalPaths;
 }
 
-// Part 1 solution
-void solvePart1(const std::string& filename = "") {
-    std::vector<std::string> grid;
+// Timeline counts for a beam starting at any cell, filled bottom-up in one pass: a beam on
+// the last row is one timeline, a beam leaving the grid sideways is one timeline, a splitter
+// adds up the counts below-left and below-right and any other cell takes the count below.
+// count(startRow, startCol) is the Part 2 answer, and every other entry is the answer for
+// a beam injected there instead, each available in O(1) after construction.
+template <typename Count = long long>
+class TimelineTable {
+public:
+    explicit TimelineTable(const std::vector<std::string>& grid, const Count& one = Count(1))
+        : rows(grid.size()), cols(grid[0].size()), one(one), counts((size_t)rows * cols, one) {
+        for (int r = rows - 2; r >= 0; --r) {
+            const Count* below = &counts[(size_t)(r + 1) * cols];
+            Count* here = &counts[(size_t)r * cols];
+            for (int c = 0; c < cols; ++c) {
+                if (grid[r][c] == '^') {
+                    here[c] = (c > 0 ? below[c - 1] : one) + (c + 1 < cols ? below[c + 1] : one);
+                } else {
+                    here[c] = below[c];
+                }
+            }
+        }
+    }
     
+    // Timelines for a beam at (row, col); a column off the grid has already exited
+    Count count(int row, int col) const {
+        if (col < 0 || col >= cols) return one;
+        return counts[(size_t)row * cols + col];
+    }
+    
+    int rowCount() const { return rows; }
+    int columnCount() const { return cols; }
+    
+private:
+    int rows, cols;
+    Count one;
+    std::vector<Count> counts;
+};
+
+// Reads the grid from the file, or from stdin when no file is given
+bool readGrid(const std::string& filename, std::vector<std::string>& grid) {
+    std::ifstream inputFile;
     if (!filename.empty()) {
-        // Read directly from the file
-        std::ifstream inputFile(filename);
+        inputFile.open(filename);
         if (!inputFile.is_open()) {
-            std::cerr << "Error: Could not open file " << filename << " in solvePart1" << std::endl;
-            return;
-        }
-        
-        std::string line;
-        while (std::getline(inputFile, line)) {
-            grid.push_back(line);
-        }
-    } else {
-        // Read from stdin
-        std::string line;
-        while (std::getline(std::cin, line)) {
-            grid.push_back(line);
+            std::cerr << "Error: Could not open file " << filename << std::endl;
+            return false;
         }
     }
+    std::istream& in = filename.empty() ? std::cin : inputFile;
+    std::string line;
+    while (std::getline(in, line)) {
+        grid.push_back(line);
+    }
+    return !grid.empty();
+}
+
+// Part 1 solution
+void solvePart1(const std::string& filename = "") {
+    std::vector<std::string> grid;
+    if (!readGrid(filename, grid)) return;
     
     std::cout << "Read " << grid.size() << " lines from input" << std::endl;
     
@@ -190,36 +312,65 @@ void solvePart1(const std::string& filename = "") {
     std::cout << "\nPart 1 Answer: " << result << std::endl;
 }
 
-// Part 2 solution
-void solvePart2(const std::string& filename = "") {
-    std::vector<std::string> grid;
+// Calls solve(zero, one) with the narrowest count type that cannot overflow on this grid
+// (every row with splitters can at most double the number of timelines), or with counts
+// modulo modulus when it is non-zero
+template <typename Solve>
+void withCountType(const std::vector<std::string>& grid, unsigned long long modulus, Solve solve) {
+    int splitterRows = std::count_if(grid.begin(), grid.end(), [](const std::string& row) {
+        return row.find('^') != std::string::npos;
+    });
     
-    if (!filename.empty()) {
-        // Read directly from the file
-        std::ifstream inputFile(filename);
-        if (!inputFile.is_open()) {
-            std::cerr << "Error: Could not open file " << filename << " in solvePart2" << std::endl;
-            return;
-        }
-        
-        std::string line;
-        while (std::getline(inputFile, line)) {
-            grid.push_back(line);
-        }
+    if (modulus != 0) {
+        solve(ModularCount(0, modulus), ModularCount(1, modulus));
+    } else if (splitterRows < 63) {
+        solve(0LL, 1LL);
+    } else if (splitterRows < 256) {
+        solve(FixedBigInt<4>(0), FixedBigInt<4>(1));
+    } else if (splitterRows < 1024) {
+        solve(FixedBigInt<16>(0), FixedBigInt<16>(1));
+    } else if (splitterRows < 4096) {
+        solve(FixedBigInt<64>(0), FixedBigInt<64>(1));
     } else {
-        // Read from stdin
-        std::string line;
-        while (std::getline(std::cin, line)) {
-            grid.push_back(line);
-        }
+        std::cerr << "Error: " << splitterRows << " rows with splitters is too deep for exact counts, "
+                  << "give a modulus to count modulo it" << std::endl;
     }
+}
+
+// Part 2 solution
+void solvePart2(const std::string& filename = "", unsigned long long modulus = 0) {
+    std::vector<std::string> grid;
+    if (!readGrid(filename, grid)) return;
     
     std::cout << "Read " << grid.size() << " lines from input" << std::endl;
     
     // Count the number of unique timelines
-    long long result = countTimelines(grid);
+    withCountType(grid, modulus, [&](auto zero, auto one) {
+        auto result = countTimelines(grid, zero, one);
+        std::cout << "\nPart 2 Answer: " << result << std::endl;
+    });
+}
+
+// Timelines for the beam entering at every column of the 'S' row (the top row if there is no 'S')
+void solveAllColumns(const std::string& filename = "", unsigned long long modulus = 0) {
+    std::vector<std::string> grid;
+    if (!readGrid(filename, grid)) return;
+    
+    int startRow = 0;
+    for (int r = 0; r < (int)grid.size(); ++r) {
+        if (grid[r].find('S') != std::string::npos) {
+            startRow = r;
+            break;
+        }
+    }
     
-    std::cout << "\nPart 2 Answer: " << result << std::endl;
+    withCountType(grid, modulus, [&](auto, auto one) {
+        TimelineTable<decltype(one)> table(grid, one);
+        std::cout << "Timelines by entry column on row " << startRow << ":" << std::endl;
+        for (int c = 0; c < table.columnCount(); ++c) {
+            std::cout << "Column " << c << ": " << table.count(startRow, c) << std::endl;
+        }
+    });
 }
 
 int main(int argc, char* argv[]) {
@@ -227,10 +378,19 @@ int main(int argc, char* argv[]) {
     if (argc > 1) {
         std::cout << "Using file: " << argv[1] << std::endl;
         
-        // Check if we should solve part 1 or part 2
-        if (argc > 2 && std::string(argv[2]) == "part2") {
+        // Timeline counts are exact, or modulo argv[3] when it is given
+        unsigned long long modulus = (argc > 3) ? std::stoull(argv[3]) : 0;
+        if (modulus >= (1ULL << 63)) {
+            std::cerr << "Error: the modulus must be below 2^63" << std::endl;
+            return 1;
+        }
+        
+        // Check if we should solve part 1 or part 2, or list every entry column
+        if (argc > 2 && std::string(argv[2]) == "columns") {
+            solveAllColumns(argv[1], modulus);
+        } else if (argc > 2 && std::string(argv[2]) == "part2") {
             // Solve part 2 with the provided file
-            solvePart2(argv[1]);
+            solvePart2(argv[1], modulus);
         } else {
             // Solve part 1 with the provided file
             solvePart1(argv[1]);
@@ -8,6 +8,8 @@
 #include <cmath>
 #include <queue>
 #include <unordered_map>
+#include <tuple>
+#include <functional>
 
 // Structure to represent a junction box
 struct JunctionBox {
@@ -29,7 +31,12 @@ struct Connection {
 std::vector<std::vector<int>> inputValues;
 std::vector<JunctionBox> junctionBoxes;
 
-void getinput(){
+// Largest coordinate magnitude accepted: differences stay within 2^25, so a squared
+// distance is below 3 * 2^50
+const int MAX_COORDINATE = 1 << 24;
+
+// Returns false when a junction box lies outside the supported coordinate range
+bool getinput(){
     std::string line;
     int id = 0;
     while (std::getline(std::cin, line)) {
@@ -48,17 +55,16 @@ void getinput(){
             box.y = convertedValues[1];
             box.z = convertedValues[2];
             box.id = id++;
+            for (int coordinate : {box.x, box.y, box.z}) {
+                if (coordinate < -MAX_COORDINATE || coordinate > MAX_COORDINATE) {
+                    std::cerr << "Error: coordinate " << coordinate << " is outside +/-" << MAX_COORDINATE << std::endl;
+                    return false;
+                }
+            }
             junctionBoxes.push_back(box);
         }
     }
-}
-
-// Calculate Euclidean distance between two junction boxes
-double calculateDistance(const JunctionBox& box1, const JunctionBox& box2) {
-    double dx = box1.x - box2.x;
-    double dy = box1.y - box2.y;
-    double dz = box1.z - box2.z;
-    return std::sqrt(dx*dx + dy*dy + dz*dz);
+    return true;
 }
 
 // Find the root of a set (for Union-Find algorithm)
@@ -85,21 +91,155 @@ void unionSets(std::vector<int>& parent, std::vector<int>& size, int x, int y) {
         }
     }
 }
+// Squared Euclidean distance in exact integers. getinput keeps coordinates within
+// MAX_COORDINATE, so the squares stay below 2^53: they neither overflow nor lose precision
+// as doubles, and ordering by them is the same as ordering by the Euclidean distance.
+long long squaredDistance(const JunctionBox& box1, const JunctionBox& box2) {
+    long long dx = (long long)box1.x - box2.x;
+    long long dy = (long long)box1.y - box2.y;
+    long long dz = (long long)box1.z - box2.z;
+    return dx*dx + dy*dy + dz*dz;
+}
+
+// A neighbour found by the k-d tree: squared distance, then id to break ties
+typedef std::pair<long long, int> Neighbour;
+
+// Balanced k-d tree stored implicitly in an array of box ids: the median of [lo, hi)
+// along axis depth % 3 sits at the midpoint, with the lower half to its left
+class KdTree {
+public:
+    explicit KdTree(const std::vector<JunctionBox>& boxes) : boxes(boxes), ids(boxes.size()) {
+        for (size_t i = 0; i < ids.size(); i++) {
+            ids[i] = i;
+        }
+        build(0, ids.size(), 0);
+    }
+    
+    // The k boxes closest to box query (not counting itself), ordered by (distance, id)
+    std::vector<Neighbour> nearest(int query, int k) const {
+        std::priority_queue<Neighbour> best; // the worst of the k kept so far on top
+        search(boxes[query], query, k, 0, ids.size(), 0, best);
+        std::vector<Neighbour> result(best.size());
+        for (size_t i = result.size(); i-- > 0; best.pop()) {
+            result[i] = best.top();
+        }
+        return result;
+    }
+    
+private:
+    static int coordinate(const JunctionBox& box, int axis) {
+        return axis == 0 ? box.x : (axis == 1 ? box.y : box.z);
+    }
+    
+    void build(size_t lo, size_t hi, int depth) {
+        if (hi - lo <= 1) return;
+        size_t mid = (lo + hi) / 2;
+        int axis = depth % 3;
+        std::nth_element(ids.begin() + lo, ids.begin() + mid, ids.begin() + hi, [&](int a, int b) {
+            return coordinate(boxes[a], axis) < coordinate(boxes[b], axis);
+        });
+        build(lo, mid, depth + 1);
+        build(mid + 1, hi, depth + 1);
+    }
+    
+    void search(const JunctionBox& target, int query, int k, size_t lo, size_t hi, int depth,
+                std::priority_queue<Neighbour>& best) const {
+        if (lo >= hi) return;
+        size_t mid = (lo + hi) / 2;
+        int id = ids[mid];
+        if (id != query) {
+            Neighbour candidate(squaredDistance(target, boxes[id]), id);
+            if ((int)best.size() < k) {
+                best.push(candidate);
+            } else if (candidate < best.top()) {
+                best.pop();
+                best.push(candidate);
+            }
+        }
+        
+        // Near side first; the far side can only help if the splitting plane is no farther
+        // than the worst kept neighbour (equal distances still matter for the id tie-break)
+        int axis = depth % 3;
+        long long offset = (long long)coordinate(target, axis) - coordinate(boxes[id], axis);
+        bool leftFirst = offset < 0;
+        search(target, query, k, leftFirst ? lo : mid + 1, leftFirst ? mid : hi, depth + 1, best);
+        if ((int)best.size() < k || offset * offset <= best.top().first) {
+            search(target, query, k, leftFirst ? mid + 1 : lo, leftFirst ? hi : mid, depth + 1, best);
+        }
+    }
+    
+    const std::vector<JunctionBox>& boxes;
+    std::vector<int> ids;
+};
+
+// Yields the connections shortest first, without building all n^2/2 of them. Each box
+// walks its own neighbours, k at a time from the k-d tree (k doubles whenever they run
+// out), and a heap holds the next connection of every box. A connection is reached from
+// both of its ends, and the two copies are adjacent in the heap order, so the second is
+// dropped. Equal distances come out by (box1, box2), the order the all-pairs loop
+// generates them in.
+class ConnectionStream {
+public:
+    explicit ConnectionStream(const std::vector<JunctionBox>& boxes)
+        : boxes(boxes), tree(boxes), walks(boxes.size()) {
+        for (int i = 0; i < (int)boxes.size(); i++) {
+            pushNext(i);
+        }
+    }
+    
+    bool next(Connection& conn) {
+        while (!pending.empty()) {
+            auto [distance, box1, box2, owner] = pending.top();
+            pending.pop();
+            pushNext(owner);
+            if (box1 == lastBox1 && box2 == lastBox2) continue;
+            lastBox1 = box1;
+            lastBox2 = box2;
+            conn.box1 = box1;
+            conn.box2 = box2;
+            conn.distance = std::sqrt((double)distance);
+            return true;
+        }
+        return false;
+    }
+    
+private:
+    // The neighbours of one box fetched so far, and how many have been used
+    struct Walk {
+        std::vector<Neighbour> neighbours;
+        size_t used = 0;
+        int k = 0;
+    };
+    
+    void pushNext(int box) {
+        Walk& walk = walks[box];
+        int others = (int)boxes.size() - 1;
+        while (walk.used == walk.neighbours.size()) {
+            if (walk.k >= others) return; // every other box has been seen
+            walk.k = std::min(others, walk.k == 0 ? INITIAL_NEIGHBOURS : 2 * walk.k);
+            walk.neighbours = tree.nearest(box, walk.k);
+        }
+        const auto& [distance, other] = walk.neighbours[walk.used++];
+        pending.emplace(distance, std::min(box, other), std::max(box, other), box);
+    }
+    
+    static const int INITIAL_NEIGHBOURS = 8;
+    
+    const std::vector<JunctionBox>& boxes;
+    KdTree tree;
+    std::vector<Walk> walks;
+    // (distance, box1, box2, box whose walk it came from), smallest on top
+    typedef std::tuple<long long, int, int, int> Pending;
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending>> pending;
+    int lastBox1 = -1, lastBox2 = -1;
+};
+
 // Part 1 solution
 void solvePart1() {
     int numBoxes = junctionBoxes.size();
     
-    // Calculate distances between all pairs of junction boxes
-    std::priority_queue<Connection> connections;
-    for (int i = 0; i < numBoxes; i++) {
-        for (int j = i + 1; j < numBoxes; j++) {
-            Connection conn;
-            conn.box1 = i;
-            conn.box2 = j;
-            conn.distance = calculateDistance(junctionBoxes[i], junctionBoxes[j]);
-            connections.push(conn);
-        }
-    }
+    // Connections between junction boxes, shortest first
+    ConnectionStream connections(junctionBoxes);
     
     // Initialize Union-Find data structures
     std::vector<int> parent(numBoxes);
@@ -116,11 +256,8 @@ void solvePart1() {
         connectionsToMake = 1000;
     }
     
-    connectionsToMake = std::min(connectionsToMake, (int)connections.size());
-    for (int i = 0; i < connectionsToMake; i++) {
-        Connection conn = connections.top();
-        connections.pop();
-        
+    Connection conn;
+    for (int i = 0; i < connectionsToMake && connections.next(conn); i++) {
         // Connect the two junction boxes
         unionSets(parent, size, conn.box1, conn.box2);
     }
@@ -154,17 +291,8 @@ void solvePart1() {
 void solvePart2() {
     int numBoxes = junctionBoxes.size();
     
-    // Calculate distances between all pairs of junction boxes
-    std::priority_queue<Connection> connections;
-    for (int i = 0; i < numBoxes; i++) {
-        for (int j = i + 1; j < numBoxes; j++) {
-            Connection conn;
-            conn.box1 = i;
-            conn.box2 = j;
-            conn.distance = calculateDistance(junctionBoxes[i], junctionBoxes[j]);
-            connections.push(conn);
-        }
-    }
+    // Connections between junction boxes, shortest first
+    ConnectionStream connections(junctionBoxes);
     
     // Initialize Union-Find data structures
     std::vector<int> parent(numBoxes);
@@ -177,10 +305,8 @@ void solvePart2() {
     int numSets = numBoxes; // Initially, each junction box is in its own set
     int lastBox1 = -1, lastBox2 = -1;
     
-    while (numSets > 1 && !connections.empty()) {
-        Connection conn = connections.top();
-        connections.pop();
-        
+    Connection conn;
+    while (numSets > 1 && connections.next(conn)) {
         int root1 = findRoot(parent, conn.box1);
         int root2 = findRoot(parent, conn.box2);
         
@@ -203,7 +329,7 @@ void solvePart2() {
 
 int main() {
     // Solve both parts
-    getinput();
+    if (!getinput()) return 1;
     solvePart1();
     solvePart2();
     return 0;